@@ -22,6 +22,12 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 
 #pragma once
 #include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+#include "GameContext.h"
+#include "CheckersEngine.h"
+#include "CheckersSearch.h"
+#include "CheckersTablebase.h"
+#include "CheckersBook.h"
 
 // Ensures that all game functions are unique and won't generate linker errors if we switch strategies.
 // Assign a gamecode by changing the text before the ## symbols.  Use format [Three Letters]_
@@ -38,41 +44,153 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 #define OFFCOLOR GC_GRAY
 #define MOVECOLOR GC_YELLOW
 
+// Computer player.  Games get no clock from the firmware, so its thinking time
+// is turned into a node budget at the rate the table's CPU searches.  Each
+// table starts at AI_MOVESECONDS a move, see Checkers_SetMoveTime.
+#define AI_MOVESECONDS 2
+#define AI_NODESPERSECOND 200000
+#define AI_TTENTRIES 2048
+
 // Menu IDs
 // Setup
 #define MSLOT_S_STARTGAME 0
 #define MSLOT_S_TT 1
+#define MSLOT_S_COMPUTER 2
 
 // Game
 #define MSLOT_G_RESTART 0
 #define MSLOT_G_RECONFIGURE 1
+#define MSLOT_G_SUGGEST 2
+
+// Gameplay Variables.  One set per table, see GameContext.h.
+typedef struct
+{
+	unsigned char bIsSetup; // 1 if setup phase, 0 if game phase.
+	unsigned char iBoardSize;
+	short timerEnable;
+	unsigned char bComputerPlayer; // 1 if the computer plays player 2
+
+	int turnCount;
+	long aiMoveMillis; // thinking time for the computer player and Suggest Move
+	long clockMillis[2]; // each side's LCD timer, less what the table has thought for them
+
+	// Everything we draw goes through here and reaches the LEDs once per callback.
+	LEDFrameBuffer frameBuffer;
+
+	// The board is kept here and the LEDs only ever show it, never get read back.
+	unsigned char board[LIGHTSBOARDSIZE][LIGHTSBOARDSIZE]; // piece color on each square, OFFCOLOR if empty
+	unsigned char marks[LIGHTSBOARDSIZE][LIGHTSBOARDSIZE]; // MOVECOLOR/JUMPCOLOR highlights, 0 if none
+
+	// The same pieces as bitboards for the move generator, kept in step by SetPiece.
+	CheckersPosition pos;
+
+	// Positions since the last capture or man move, for spotting draws.
+	CheckersHistory history;
+	unsigned char bIrreversible; // 1 once this turn has captured or moved a man
+
+	CheckersTT tt;
+	CheckersTTEntry ttEntries[AI_TTENTRIES];
+	unsigned int bookRandom; // picks among the book's replies; not reset between games, so they open differently
+
+	// Every legal move for the side to move, generated once at the start of the turn.
+	CheckersMoveList moves;
+
+	// Pieces each side has left, counted down by MovePiece.
+	int p1Pieces;
+	int p2Pieces;
+
+	// MakeMove's selection, carried between presses.
+	int jumpString; // 1 once a capture is under way and the piece can't be changed
+	unsigned char chain[CK_MAXHOPS + 1]; // the selected piece's square, then each square it has landed on
+	int chainHops;
+} CheckersContext;
 
-// Gameplay Variables
-static unsigned char m_bIsSetup; // 1 if setup phase, 0 if game phase.
-static unsigned char m_iBoardSize;
-static short timerEnable = 0;
+DECLARE_GAME_CONTEXT(CheckersContext)
 
-static int turnCount = 0;
+// Endgame tables and opening book, shared read-only by every table.  0 if there are none.
+static const CheckersTablebase *m_pTablebase;
+static const CheckersBook *m_pBook;
 
 // Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
-static int DisplayMoves(int x, int y, int jump, int canJump, int checkMode);
+#define OFFBOARD -1
+
+static int PieceAt(CheckersContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return OFFBOARD;
+
+	return ctx->board[x][y];
+}
+
+static int MarkAt(CheckersContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return 0;
+
+	return ctx->marks[x][y];
+}
+
+//Pushes a square to its LED.  Highlights are drawn over whatever is underneath.
+static void DrawSquare(CheckersContext *ctx, int x, int y)
+{
+	FB_IlluminateButton(&ctx->frameBuffer, x, y, ctx->marks[x][y] ? ctx->marks[x][y] : ctx->board[x][y]);
+}
+
+static void SetPiece(CheckersContext *ctx, int x, int y, int color)
+{
+	int s = CK_Square(x, y);
+
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return;
+
+	ctx->board[x][y] = (unsigned char)color;
+	DrawSquare(ctx, x, y);
 
-static unsigned short InitSetupPhase(unsigned short freshConfiguration)
+	if (s < 0)
+		return;
+	if (color == OFFCOLOR)
+		CK_RemovePiece(&ctx->pos, s);
+	else
+		CK_PutPiece(&ctx->pos, s, color == P2COLOR || color == P2KINGCOLOR, color == P1KINGCOLOR || color == P2KINGCOLOR);
+}
+
+static void SetMark(CheckersContext *ctx, int x, int y, int color)
 {
-	m_bIsSetup = 1;
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return;
+
+	ctx->marks[x][y] = (unsigned char)color;
+	DrawSquare(ctx, x, y);
+}
+
+static void ClearMarks(CheckersContext *ctx)
+{
+	for (int i = 0; i < LIGHTSBOARDSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDSIZE; j++) {
+			if (ctx->marks[i][j])
+				SetMark(ctx, i, j, 0);
+		}
+	}
+}
+
+static unsigned short InitSetupPhase(CheckersContext *ctx, unsigned short freshConfiguration)
+{
+	ctx->bIsSetup = 1;
 
 	if (freshConfiguration) // Do initial setup stuff here that should only happen on fresh reloads.
 	{
 		// Create our "home" configuration.
-		SetBoardSize(LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
-		IlluminateBoard(OFFCOLOR);
+		FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
+		FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
-		timerEnable = 0;
+		ctx->timerEnable = 0;
+		ctx->bComputerPlayer = 0;
+		ctx->aiMoveMillis = AI_MOVESECONDS * 1000L;
 		SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP);
 	}
 	else // Do any cleanup here to freeze the gamestate of a previous playthrough.
 	{
-		if (timerEnable == 1) {
+		if (ctx->timerEnable == 1) {
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 1);
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER2, 1);
 		}
@@ -88,15 +206,64 @@ static unsigned short InitSetupPhase(unsigned short freshConfiguration)
 	else
 		RegisterMenuOption(SPT_OPTIONS_RESTARTGAME, IMAGEID_NONE, MSLOT_S_STARTGAME);
 
-	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_COMPUTERPLAYER, IMAGEID_NONE, ctx->bComputerPlayer ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_COMPUTER);
 
 	// Nothing that can cause errors here, really, so always return 0.
 	return 0;
 }
 
-static void InitGamePhase()
+static void EndGame(CheckersContext *ctx, int winningColor)
 {
-	m_bIsSetup = 0;
+
+	char victory;
+
+	switch (winningColor) {
+	case P1COLOR: victory = SPT_GAMEMESSAGE_REDVICTORY;
+	case P1KINGCOLOR: victory = SPT_GAMEMESSAGE_REDVICTORY; break;
+	case P2COLOR: victory = SPT_GAMEMESSAGE_BLUEVICTORY;
+	case P2KINGCOLOR: victory = SPT_GAMEMESSAGE_BLUEVICTORY; break;
+	}
+
+	ClearMarks(ctx);
+	SetLCDGameMessage(victory);
+	InitSetupPhase(ctx, 0);
+}
+
+static void DrawGame(CheckersContext *ctx)
+{
+	ClearMarks(ctx);
+	SetLCDGameMessage(SPT_GAMEMESSAGE_TIEGAME);
+	InitSetupPhase(ctx, 0);
+}
+
+//Gets the turn's moves ready.  The pieces of the side to move that have no move are dimmed so
+//the ones that do stand out, and a side that can't move at all has lost.  Returns 0 if the game is over.
+static int StartTurn(CheckersContext *ctx)
+{
+	unsigned int movers = 0;
+
+	ClearMarks(ctx);
+	ctx->jumpString = 0;
+	ctx->chainHops = 0;
+	if (CK_GenerateMoves(&ctx->pos, &ctx->moves) == 0) {
+		EndGame(ctx, ctx->pos.side == 0 ? P2COLOR : P1COLOR);
+		return 0;
+	}
+
+	for (int i = 0; i < ctx->moves.count; i++)
+		movers |= 1u << ctx->moves.moves[i].from;
+	for (unsigned int stuck = ctx->pos.pieces[ctx->pos.side] & ~movers; stuck; stuck &= stuck - 1) {
+		int x = CK_SquareX(CK_Lowest(stuck)), y = CK_SquareY(CK_Lowest(stuck));
+
+		SetMark(ctx, x, y, PieceAt(ctx, x, y) + GC_DARK);
+	}
+	return 1;
+}
+
+static void InitGamePhase(CheckersContext *ctx)
+{
+	ctx->bIsSetup = 0;
 
 	// Play our start que
 	PlaySoundPreset(SOUNDID_GAMESTART);
@@ -109,197 +276,120 @@ static void InitGamePhase()
 	SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSTART);
 
 	// Create our starting LED configuration.
-	SetBoardSize(LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
-	IlluminateBoard(OFFCOLOR);
-
-	//P1 Board
-	IlluminateButton(0, 7, P1COLOR);
-	IlluminateButton(2, 7, P1COLOR);
-	IlluminateButton(4, 7, P1COLOR);
-	IlluminateButton(6, 7, P1COLOR);
-	IlluminateButton(0, 5, P1COLOR);
-	IlluminateButton(2, 5, P1COLOR);
-	IlluminateButton(4, 5, P1COLOR);
-	IlluminateButton(6, 5, P1COLOR);
-	IlluminateButton(1, 6, P1COLOR);
-	IlluminateButton(3, 6, P1COLOR);
-	IlluminateButton(5, 6, P1COLOR);
-	IlluminateButton(7, 6, P1COLOR);
-
-	//P2 Board
-	IlluminateButton(0, 1, P2COLOR);
-	IlluminateButton(2, 1, P2COLOR);
-	IlluminateButton(4, 1, P2COLOR);
-	IlluminateButton(6, 1, P2COLOR);
-	IlluminateButton(1, 0, P2COLOR);
-	IlluminateButton(3, 0, P2COLOR);
-	IlluminateButton(5, 0, P2COLOR);
-	IlluminateButton(7, 0, P2COLOR);
-	IlluminateButton(1, 2, P2COLOR);
-	IlluminateButton(3, 2, P2COLOR);
-	IlluminateButton(5, 2, P2COLOR);
-	IlluminateButton(7, 2, P2COLOR);
-
-	if (timerEnable) {
+	FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
+	FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
+
+	//pieces go on the dark squares of the three rows nearest each player
+	CK_Clear(&ctx->pos);
+	for (int i = 0; i < LIGHTSBOARDSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDSIZE; j++) {
+			ctx->board[i][j] = OFFCOLOR;
+			ctx->marks[i][j] = 0;
+
+			if ((i + j) % 2 == 1) {
+				if (j >= 5)
+					SetPiece(ctx, i, j, P1COLOR);
+				else if (j <= 2)
+					SetPiece(ctx, i, j, P2COLOR);
+			}
+		}
+	}
+
+	if (ctx->timerEnable) {
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER1, 1200); // Timer starts at 1200 seconds
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER2, 1200); // Timer starts at 1200 seconds
 		SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 3);
 	}
 
-	turnCount = 0;
+	ctx->turnCount = 0;
+	ctx->clockMillis[0] = ctx->clockMillis[1] = 1200 * 1000L;
+	ctx->p1Pieces = 12;
+	ctx->p2Pieces = 12;
+	ctx->jumpString = 0;
+
+	CK_ResetHistory(&ctx->history, &ctx->pos);
+	ctx->bIrreversible = 0;
+	CK_InitTT(&ctx->tt, ctx->ttEntries, AI_TTENTRIES);
 
 	// Init our game phase menu.
 	ClearAllMenuOptions();
 	RegisterMenuOption(SPT_OPTIONS_RESTART, IMAGEID_NONE, MSLOT_G_RESTART);
 	RegisterMenuOption(SPT_OPTIONS_RECONFIGURE, IMAGEID_NONE, MSLOT_G_RECONFIGURE);
+	RegisterMenuOption(SPT_OPTIONS_SUGGESTMOVE, IMAGEID_NONE, MSLOT_G_SUGGEST);
+
+	StartTurn(ctx);
 }
 
-static void EndGame(int winningColor)
+// Presses a move takes: one per hop, or one for a plain step.
+static int MoveLength(const CheckersMove *move)
 {
-
-	char victory;
-
-	switch (winningColor) {
-	case P1COLOR: victory = SPT_GAMEMESSAGE_REDVICTORY;
-	case P1KINGCOLOR: victory = SPT_GAMEMESSAGE_REDVICTORY; break;
-	case P2COLOR: victory = SPT_GAMEMESSAGE_BLUEVICTORY;
-	case P2KINGCOLOR: victory = SPT_GAMEMESSAGE_BLUEVICTORY; break;
-	}
-
-	SetLCDGameMessage(victory);
-	InitSetupPhase(0);
+	return move->hops ? move->hops : 1;
 }
 
-//Logic for checking if a jump is available on the board
-static int CheckJumps(int color, int kingColor)
+// Whether a move from the turn's list carries on from what the selected piece has done so far.
+static int FollowsChain(CheckersContext *ctx, const CheckersMove *move)
 {
-
-	for (int i = 0; i < 8; i++) {
-		for (int j = 0; j < 8; j++) {
-			if (GetButtonColorAtPos(i, j) == color || GetButtonColorAtPos(i, j) == kingColor) {
-				if (DisplayMoves(i, j, 0, 0, 1) == 1) {
-					return 1;
-				}
-			}
-		}
+	for (int i = 0; i <= ctx->chainHops; i++) {
+		if (move->path[i] != ctx->chain[i])
+			return 0;
 	}
-
-	return 0;
+	return 1;
 }
 
-static int DisplayMoves(int x, int y, int jump, int canJump, int checkMode)
+//Marks the rest of one move's path: JUMPCOLOR on the way, MOVECOLOR where it finishes.
+static void ShowMove(CheckersContext *ctx, const CheckersMove *move)
 {
-	int color = GetButtonColorAtPos(x, y), displayColor = MOVECOLOR;
-	int leftY, rightY, leftJumpY, rightJumpY, king = 0, enemy, enemyKing;
-	int flag = 0;
-
-	switch (color) {
-	case P1COLOR: leftY = -1; rightY = -1; leftJumpY = -2; rightJumpY = -2; enemy = P2COLOR; enemyKing = P2KINGCOLOR; break;
-	case P2COLOR: leftY = 1; rightY = 1; leftJumpY = 2; rightJumpY = 2; enemy = P1COLOR; enemyKing = P1KINGCOLOR; break;
-	case P1KINGCOLOR: king = 1; enemy = P2COLOR; enemyKing = P2KINGCOLOR; break;
-	case P2KINGCOLOR: king = 1; enemy = P1COLOR; enemyKing = P1KINGCOLOR; break;
-	}
-
-	if (jump == 1)
-		displayColor = GC_PINK;
-
-	//king moves
-	if (king == 1) {
-
-		//jumps
-		if ((GetButtonColorAtPos(x - 1, y - 1) == enemy || GetButtonColorAtPos(x - 1, y - 1) == enemyKing) && GetButtonColorAtPos(x - 2, y - 2) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x - 2, y - 2, displayColor);
-			flag = 1;
-		}
-		if ((GetButtonColorAtPos(x + 1, y - 1) == enemy || GetButtonColorAtPos(x + 1, y - 1) == enemyKing) && GetButtonColorAtPos(x + 2, y - 2) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x + 2, y - 2, displayColor);
-			flag = 1;
-		}
-		if ((GetButtonColorAtPos(x - 1, y + 1) == enemy || GetButtonColorAtPos(x - 1, y + 1) == enemyKing) && GetButtonColorAtPos(x - 2, y + 2) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x - 2, y + 2, displayColor);
-			flag = 1;
-		}
-		if ((GetButtonColorAtPos(x + 1, y + 1) == enemy || GetButtonColorAtPos(x + 1, y + 1) == enemyKing) && GetButtonColorAtPos(x + 2, y + 2) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x + 2, y + 2, displayColor);
-			flag = 1;
-		}
+	int length = MoveLength(move);
 
-		if (checkMode == 1)
-			return flag;
-
-		//normal moves
-		if (GetButtonColorAtPos(x - 1, y - 1) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x - 1, y - 1, displayColor);
-		if (GetButtonColorAtPos(x + 1, y - 1) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x + 1, y - 1, displayColor);
-		if (GetButtonColorAtPos(x - 1, y + 1) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x - 1, y + 1, displayColor);
-		if (GetButtonColorAtPos(x + 1, y + 1) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x + 1, y + 1, displayColor);
+	for (int j = ctx->chainHops + 1; j < length; j++) {
+		if (MarkAt(ctx, CK_SquareX(move->path[j]), CK_SquareY(move->path[j])) != MOVECOLOR)
+			SetMark(ctx, CK_SquareX(move->path[j]), CK_SquareY(move->path[j]), JUMPCOLOR);
 	}
+	SetMark(ctx, CK_SquareX(move->path[length]), CK_SquareY(move->path[length]), MOVECOLOR);
+}
 
-	//regular piece moves
-	else {
-
-		//jumps
-		if ((GetButtonColorAtPos(x - 1, y + leftY) == enemy || GetButtonColorAtPos(x - 1, y + leftY) == enemyKing) && GetButtonColorAtPos(x - 2, y + leftJumpY) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x - 2, y + leftJumpY, displayColor);
-			flag = 1;
-		}
-		if ((GetButtonColorAtPos(x + 1, y + rightY) == enemy || GetButtonColorAtPos(x + 1, y + rightY) == enemyKing) && GetButtonColorAtPos(x + 2, y + rightJumpY) == OFFCOLOR) {
-			if (checkMode != 1)
-				IlluminateButton(x + 2, y + rightJumpY, displayColor);
-			flag = 1;
-		}
+//Highlights everywhere the selected piece can still get to this turn: MOVECOLOR where a move
+//finishes and JUMPCOLOR on the squares a longer capture passes through on the way.  Any capture
+//on the board means only captures are offered.  Returns how many moves were shown.
+static int DisplayMoves(CheckersContext *ctx)
+{
+	int count = 0;
 
-		if (checkMode == 1)
-			return flag;
+	for (int i = 0; i < ctx->moves.count; i++) {
+		const CheckersMove *move = &ctx->moves.moves[i];
 
-		//normal moves
-		if (GetButtonColorAtPos(x - 1, y + leftY) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x - 1, y + leftY, displayColor);
-		if (GetButtonColorAtPos(x + 1, y + rightY) == OFFCOLOR && jump != 1 && canJump != 1)
-			IlluminateButton(x + 1, y + rightY, displayColor);
+		if (!FollowsChain(ctx, move))
+			continue;
+		ShowMove(ctx, move);
+		count++;
 	}
 
-	return flag;
+	return count;
 }
 
-static void EraseMoves(int x, int y) {
+//Takes down the highlights DisplayMoves put up.  The dimmed pieces stay for the rest of the turn.
+static void EraseMoves(CheckersContext *ctx) {
 
-	if (GetButtonColorAtPos(x - 1, y - 1) == MOVECOLOR)
-		IlluminateButton(x - 1, y - 1, OFFCOLOR);
-	if (GetButtonColorAtPos(x + 1, y - 1) == MOVECOLOR)
-		IlluminateButton(x + 1, y - 1, OFFCOLOR);
-	if (GetButtonColorAtPos(x - 1, y + 1) == MOVECOLOR)
-		IlluminateButton(x - 1, y + 1, OFFCOLOR);
-	if (GetButtonColorAtPos(x + 1, y + 1) == MOVECOLOR)
-		IlluminateButton(x + 1, y + 1, OFFCOLOR);
-	if (GetButtonColorAtPos(x - 2, y - 2) == MOVECOLOR || GetButtonColorAtPos(x - 2, y - 2) == JUMPCOLOR)
-		IlluminateButton(x - 2, y - 2, OFFCOLOR);
-	if (GetButtonColorAtPos(x + 2, y - 2) == MOVECOLOR || GetButtonColorAtPos(x + 2, y - 2) == JUMPCOLOR)
-		IlluminateButton(x + 2, y - 2, OFFCOLOR);
-	if (GetButtonColorAtPos(x - 2, y + 2) == MOVECOLOR || GetButtonColorAtPos(x - 2, y + 2) == JUMPCOLOR)
-		IlluminateButton(x - 2, y + 2, OFFCOLOR);
-	if (GetButtonColorAtPos(x + 2, y + 2) == MOVECOLOR || GetButtonColorAtPos(x + 2, y + 2) == JUMPCOLOR)
-		IlluminateButton(x + 2, y + 2, OFFCOLOR);
+	for (int i = 0; i < LIGHTSBOARDSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDSIZE; j++) {
+			if (ctx->marks[i][j] == MOVECOLOR || ctx->marks[i][j] == JUMPCOLOR)
+				SetMark(ctx, i, j, 0);
+		}
+	}
 }
 
-static short MovePiece(int x, int y, int prevX, int prevY) {
+static short MovePiece(CheckersContext *ctx, int x, int y, int prevX, int prevY) {
 
-	static int p1Pieces = 12;
-	static int p2Pieces = 12;
 	int tempColor;
-	int color = GetButtonColorAtPos(prevX, prevY);
+	int color = PieceAt(ctx, prevX, prevY);
 
-	EraseMoves(prevX, prevY);
-	IlluminateButton(x, y, color);
-	IlluminateButton(prevX, prevY, OFFCOLOR);
+	// Only a king stepping can ever lead back to an earlier position.
+	if ((color != P1KINGCOLOR && color != P2KINGCOLOR) || x == prevX - 2 || x == prevX + 2)
+		ctx->bIrreversible = 1;
+
+	EraseMoves(ctx);
+	SetPiece(ctx, x, y, color);
+	SetPiece(ctx, prevX, prevY, OFFCOLOR);
 
 	if (color != P1KINGCOLOR && color != P2KINGCOLOR) {
 		if (y == 0 || y == 7) {
@@ -311,7 +401,7 @@ static short MovePiece(int x, int y, int prevX, int prevY) {
 			}
 
 			if (y == end)
-				IlluminateButton(x, y, kingColor);
+				SetPiece(ctx, x, y, kingColor);
 		}
 	}
 
@@ -319,60 +409,60 @@ static short MovePiece(int x, int y, int prevX, int prevY) {
 	if (x == prevX - 2 || x == prevX + 2) {
 		if (x == prevX - 2) {
 			if (y == prevY - 2) {
-				tempColor = GetButtonColorAtPos(prevX - 1, prevY - 1);
-				IlluminateButton(prevX - 1, prevY - 1, OFFCOLOR);
+				tempColor = PieceAt(ctx, prevX - 1, prevY - 1);
+				SetPiece(ctx, prevX - 1, prevY - 1, OFFCOLOR);
 				if (tempColor == P2COLOR || tempColor == P2KINGCOLOR) {
 					PrintDebugMessage("p2 piece removed\n");
-					p2Pieces--;
+					ctx->p2Pieces--;
 				}
 				else if (tempColor == P1COLOR || tempColor == P1KINGCOLOR) {
 					PrintDebugMessage("p1 piece removed\n");
-					p1Pieces--;
+					ctx->p1Pieces--;
 				}
 			}
 			else {
-				tempColor = GetButtonColorAtPos(prevX - 1, prevY + 1);
-				IlluminateButton(prevX - 1, prevY + 1, OFFCOLOR);
+				tempColor = PieceAt(ctx, prevX - 1, prevY + 1);
+				SetPiece(ctx, prevX - 1, prevY + 1, OFFCOLOR);
 				if (tempColor == P2COLOR || tempColor == P2KINGCOLOR) {
 					PrintDebugMessage("p2 piece removed\n");
-					p2Pieces--;
+					ctx->p2Pieces--;
 				}
 				else if (tempColor == P1COLOR || tempColor == P1KINGCOLOR) {
 					PrintDebugMessage("p1 piece removed\n");
-					p1Pieces--;
+					ctx->p1Pieces--;
 				}
 			}
 		}
 		else {
 			if (y == prevY - 2) {
-				tempColor = GetButtonColorAtPos(prevX + 1, prevY - 1);
-				IlluminateButton(prevX + 1, prevY - 1, OFFCOLOR);
+				tempColor = PieceAt(ctx, prevX + 1, prevY - 1);
+				SetPiece(ctx, prevX + 1, prevY - 1, OFFCOLOR);
 				if (tempColor == P2COLOR || tempColor == P2KINGCOLOR) {
 					PrintDebugMessage("p2 piece removed\n");
-					p2Pieces--;
+					ctx->p2Pieces--;
 				}
 				else if (tempColor == P1COLOR || tempColor == P1KINGCOLOR) {
 					PrintDebugMessage("p1 piece removed\n");
-					p1Pieces--;
+					ctx->p1Pieces--;
 				}
 			}
 			else {
-				tempColor = GetButtonColorAtPos(prevX + 1, prevY + 1);
-				IlluminateButton(prevX + 1, prevY + 1, OFFCOLOR);
+				tempColor = PieceAt(ctx, prevX + 1, prevY + 1);
+				SetPiece(ctx, prevX + 1, prevY + 1, OFFCOLOR);
 				if (tempColor == P2COLOR || tempColor == P2KINGCOLOR) {
 					PrintDebugMessage("p2 piece removed\n");
-					p2Pieces--;
+					ctx->p2Pieces--;
 				}
 				else if (tempColor == P1COLOR || tempColor == P1KINGCOLOR) {
 					PrintDebugMessage("p1 piece removed\n");
-					p1Pieces--;
+					ctx->p1Pieces--;
 				}
 			}
 
 		}
 
-		if (p1Pieces == 0 || p2Pieces == 0)
-			EndGame(color);
+		if (ctx->p1Pieces == 0 || ctx->p2Pieces == 0)
+			EndGame(ctx, color);
 		return 1;
 	}
 	else {
@@ -381,12 +471,75 @@ static short MovePiece(int x, int y, int prevX, int prevY) {
 
 }
 
-static void MakeMove(int x, int y) {
+//Hands the turn to the other player, unless the move just made has ended the game.  Once few
+//enough pieces are left for the endgame tables, the game is given to whoever they say wins.
+static void NextTurn(CheckersContext *ctx, char timerVal, char enemyTimer)
+{
+	int result, plies;
+
+	ctx->turnCount++;
+	CK_SetSide(&ctx->pos, ctx->turnCount % 2);
+
+	if (ctx->timerEnable) {
+		SetLCDTimerCountMode(timerVal, 1);
+		SetLCDTimerCountMode(enemyTimer, 3);
+	}
 
-	static int jumpString = 0;
-	static int previous[2];
-	static short movesDisplayed = 0;
-	int playerTurn = turnCount % 2;
+	if (CK_RecordPosition(&ctx->history, &ctx->pos, !ctx->bIrreversible))
+		DrawGame(ctx);
+	else if (m_pTablebase && !ctx->bIsSetup && (result = CK_ProbeTablebase(m_pTablebase, &ctx->pos, &plies)) != CK_TB_UNKNOWN) {
+		if (result == CK_TB_DRAWN)
+			DrawGame(ctx);
+		else
+			EndGame(ctx, (result == CK_TB_WIN) == (ctx->pos.side == 0) ? P1COLOR : P2COLOR);
+	}
+	else if (!ctx->bIsSetup)
+		StartTurn(ctx);
+	ctx->bIrreversible = 0;
+}
+
+//Carries the selected piece to (x, y), hop by hop along the shortest of its moves that gets
+//there, and ends the turn if that's the end of the move.
+static void PlayTo(CheckersContext *ctx, int x, int y, char timerVal, char enemyTimer)
+{
+	const CheckersMove *move = 0;
+	int s = CK_Square(x, y), hops = 0;
+
+	for (int i = 0; i < ctx->moves.count; i++) {
+		const CheckersMove *candidate = &ctx->moves.moves[i];
+
+		if (!FollowsChain(ctx, candidate))
+			continue;
+		for (int j = ctx->chainHops + 1; j <= MoveLength(candidate) && (!move || j < hops); j++) {
+			if (candidate->path[j] == s) {
+				move = candidate;
+				hops = j;
+			}
+		}
+	}
+	if (!move)
+		return;
+
+	for (int j = ctx->chainHops + 1; j <= hops; j++) {
+		MovePiece(ctx, CK_SquareX(move->path[j]), CK_SquareY(move->path[j]), CK_SquareX(move->path[j - 1]), CK_SquareY(move->path[j - 1]));
+		if (ctx->bIsSetup)
+			return; // that was the last enemy piece
+		ctx->chain[j] = move->path[j];
+	}
+	ctx->chainHops = hops;
+
+	// Moves that have come the same way so far land in the same position, so either all of them end here or none do.
+	if (hops == MoveLength(move))
+		NextTurn(ctx, timerVal, enemyTimer);
+	else {
+		ctx->jumpString = 1;
+		DisplayMoves(ctx);
+	}
+}
+
+static void MakeMove(CheckersContext *ctx, int x, int y) {
+
+	int playerTurn = ctx->turnCount % 2;
 	int color, kingColor;
 
 	char timerVal, enemyTimer;
@@ -396,75 +549,118 @@ static void MakeMove(int x, int y) {
 	case 1: color = P2COLOR; kingColor = P2KINGCOLOR; timerVal = TM_LCD_TIMER_PLAYER2; enemyTimer = TM_LCD_TIMER_PLAYER1; break;
 	}
 
-	if ((GetButtonColorAtPos(x, y) == color || GetButtonColorAtPos(x, y) == kingColor) && jumpString != 1) {
+	if ((PieceAt(ctx, x, y) == color || PieceAt(ctx, x, y) == kingColor) && ctx->jumpString != 1) {
 
-		if (movesDisplayed == 0) {
-			DisplayMoves(x, y, 0, CheckJumps(color, kingColor), 0);
-			movesDisplayed = 1;
-		}
-		else {
-			EraseMoves(previous[0], previous[1]);
-			DisplayMoves(x, y, 0, CheckJumps(color, kingColor), 0);
-		}
-		previous[0] = x;
-		previous[1] = y;
+		EraseMoves(ctx);
+		ctx->chain[0] = (unsigned char)CK_Square(x, y);
+		ctx->chainHops = 0;
+		DisplayMoves(ctx);
 		return;
 	}
 
-	if (GetButtonColorAtPos(x, y) == MOVECOLOR) {
+	if (MarkAt(ctx, x, y) == MOVECOLOR || MarkAt(ctx, x, y) == JUMPCOLOR)
+		PlayTo(ctx, x, y, timerVal, enemyTimer);
 
-		if (MovePiece(x, y, previous[0], previous[1]) == 1) {
-			if (DisplayMoves(x, y, 1, 0, 0)) {
-				jumpString = 1;
-				previous[0] = x;
-				previous[1] = y;
-				return;
-			}
-		}
+}
 
-		turnCount++;
-		if (timerEnable) {
-			SetLCDTimerCountMode(timerVal, 1);
-			SetLCDTimerCountMode(enemyTimer, 3);
-		}
-		movesDisplayed = 0;
-		return;
+//Thinking time for the side to move: the table's setting, but on the clock
+//never more than a twentieth of what the table reckons they have left.  The
+//reckoning only counts its own searches, so a position always gets the same
+//budget and recorded sessions replay the same.
+static long MoveMillis(CheckersContext *ctx)
+{
+	long millis = ctx->aiMoveMillis;
+
+	if (ctx->timerEnable && ctx->clockMillis[ctx->turnCount % 2] / 20 < millis)
+		millis = ctx->clockMillis[ctx->turnCount % 2] / 20;
+	return millis;
+}
+
+//Finds a move for the side to move: the book's if it knows the position, otherwise the search's.
+//Returns how many nodes were searched, 0 for a book move, or -1 if there's no move.
+static long ChooseMove(CheckersContext *ctx, long millis, CheckersMove *move)
+{
+	CheckersSearchLimits limits;
+	CheckersSearchResult result;
+
+	if (m_pBook) {
+		ctx->bookRandom = ctx->bookRandom * 1103515245u + 12345u;
+		if (CK_ProbeBook(m_pBook, &ctx->pos, ctx->bookRandom >> 8, move))
+			return 0;
 	}
 
-	if (GetButtonColorAtPos(x, y) == JUMPCOLOR) {
+	limits.maxDepth = 0;
+	limits.maxNodes = millis > 0 ? (unsigned long)(millis * (AI_NODESPERSECOND / 1000)) : 1;
+	limits.tt = &ctx->tt;
+	limits.history = &ctx->history;
+	limits.tablebase = m_pTablebase;
+
+	if (!CK_Search(&ctx->pos, &limits, &result))
+		return -1;
+	*move = result.best;
+	ctx->clockMillis[ctx->turnCount % 2] -= (long)result.nodes / (AI_NODESPERSECOND / 1000);
+	return (long)result.nodes;
+}
 
-		MovePiece(x, y, previous[0], previous[1]);
+//Finds player 2's reply and plays it through MakeMove, pressing the piece and then
+//each square it lands on, so it lights up just as a person's move does.
+static void ComputerMove(CheckersContext *ctx)
+{
+	CheckersMove move;
 
-		if (DisplayMoves(x, y, 1, 0, 0)) {
-			previous[0] = x;
-			previous[1] = y;
-		}
-		else {
-			jumpString = 0;
-			turnCount++;
-			if (timerEnable) {
-				SetLCDTimerCountMode(timerVal, 1);
-				SetLCDTimerCountMode(enemyTimer, 3);
-			}
-		}
+	if (ChooseMove(ctx, MoveMillis(ctx), &move) < 0)
+		return;
+
+	MakeMove(ctx, CK_SquareX(move.from), CK_SquareY(move.from));
+	for (int i = 1; i <= MoveLength(&move) && !ctx->bIsSetup; i++)
+		MakeMove(ctx, CK_SquareX(move.path[i]), CK_SquareY(move.path[i]));
+}
+
+//Selects the piece the computer would move for the player whose turn it is and lights just
+//that move, the piece included, which they can then play or ignore.  Not once a capture is under way.
+static void SuggestMove(CheckersContext *ctx)
+{
+	CheckersMove move;
+
+	if (ctx->jumpString || ChooseMove(ctx, MoveMillis(ctx), &move) < 0) {
+		PlaySoundPreset(SOUNDID_DENY);
+		return;
 	}
 
+	EraseMoves(ctx);
+	ctx->chain[0] = move.from;
+	ctx->chainHops = 0;
+	SetMark(ctx, CK_SquareX(move.from), CK_SquareY(move.from), MOVECOLOR);
+	ShowMove(ctx, &move);
 }
 
 // Standard Callbacks
 
 GF_PREFIX int GAMEFUNC(OnGameLoaded)()
 {
-	return InitSetupPhase(1);
+	CheckersContext *ctx = GetContext();
+	unsigned short result = InitSetupPhase(ctx, 1);
+
+	FB_Commit(&ctx->frameBuffer);
+	return result;
 }
 
 
 GF_PREFIX void GAMEFUNC(OnButtonPressed)(int x, int y)
 {
-	if (m_bIsSetup)
+	CheckersContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 		PlaySoundPreset(SOUNDID_DENY);
-	else
-		MakeMove(x, y);
+	else {
+		MakeMove(ctx, x, y);
+
+		// The computer answers as soon as the turn comes round to it.
+		if (ctx->bComputerPlayer && !ctx->bIsSetup && ctx->turnCount % 2 == 1)
+			ComputerMove(ctx);
+	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnLCDButtonPressed)(int id)
@@ -485,29 +681,40 @@ GF_PREFIX void GAMEFUNC(OnTimerFinished)(int id)
 
 GF_PREFIX void GAMEFUNC(OnLCDTimerHitZero)(int id)
 {
+	CheckersContext *ctx = GetContext();
+
 	switch (id) {
 	case TM_LCD_TIMER_PLAYER1:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	case TM_LCD_TIMER_PLAYER2:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 {
-	if (m_bIsSetup)
+	CheckersContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 	{
 		switch (id)
 		{
-		case MSLOT_S_STARTGAME: InitGamePhase(); break;
+		case MSLOT_S_STARTGAME: InitGamePhase(ctx); break;
 		case MSLOT_S_TT:
-			timerEnable = timerEnable ? 0 : 1;
+			ctx->timerEnable = ctx->timerEnable ? 0 : 1;
+
+			RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+			break;
+		case MSLOT_S_COMPUTER:
+			ctx->bComputerPlayer = ctx->bComputerPlayer ? 0 : 1;
 
-			RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+			RegisterMenuOptionWithStringParameter(SPT_OPTIONS_COMPUTERPLAYER, IMAGEID_NONE, ctx->bComputerPlayer ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_COMPUTER);
 			break;
 		}
 	}
@@ -515,10 +722,13 @@ GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 	{
 		switch (id)
 		{
-		case MSLOT_G_RESTART: InitGamePhase(); break;
-		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(0); break;
+		case MSLOT_G_RESTART: InitGamePhase(ctx); break;
+		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(ctx, 0); break;
+		case MSLOT_G_SUGGEST: SuggestMove(ctx); break;
 		}
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 // Fires when the system has not received an input for a "long time"
@@ -545,6 +755,29 @@ GF_PREFIX void GAMEFUNC(OnWake)(int reason)
 // be updated for each game.
 // ----------------------------------------------------------------------------
 
+// Gives every table the endgame tables, which must stay mapped from now on.
+// Call before any table starts playing.
+void Checkers_SetTablebase(const CheckersTablebase *tb)
+{
+	m_pTablebase = tb;
+}
+
+// The same for the opening book.
+void Checkers_SetBook(const CheckersBook *book)
+{
+	m_pBook = book;
+}
+
+// Sets how many milliseconds the computer player and Suggest Move think for
+// on the table the call comes from, which must be running Checkers.  Lasts
+// until the game is loaded again.  Turn timers can still cut it shorter.
+void Checkers_SetMoveTime(long millis)
+{
+	CheckersContext *ctx = GetContext();
+
+	ctx->aiMoveMillis = millis > 0 ? millis : 1;
+}
+
 void Checkers_RegisterGame(int id)
 {
 	BoardGameInfoList[id].printNamePreset = SPT_GT_CHECKERS;
@@ -0,0 +1,119 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersBook.c
+//# Binary search for the position, then a weighted pick among
+//# its replies.  Books are built on the host, see
+//# host/CheckersBookBuilder.c.
+//###############################################################
+#include "CheckersBook.h"
+#include "MappedFile.h"
+
+#include <string.h>
+
+#define HEADERSIZE 16
+#define ENTRYSIZE 16
+
+static unsigned long long ReadWord(const unsigned char *p, int bytes)
+{
+	unsigned long long value = 0;
+
+	while (bytes--)
+		value = (value << 8) | p[bytes];
+	return value;
+}
+
+int CK_AttachBook(CheckersBook *book, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+	unsigned long count;
+
+	memset(book, 0, sizeof(*book));
+	if (size < HEADERSIZE || memcmp(bytes, "PCBK", 4) != 0 || bytes[4] != CK_BOOK_VERSION)
+		return -1;
+	count = (unsigned long)ReadWord(bytes + 8, 4);
+	if ((size - HEADERSIZE) / ENTRYSIZE < count)
+		return -1;
+
+	book->entries = bytes + HEADERSIZE;
+	book->count = count;
+	book->size = size;
+	return 0;
+}
+
+int CK_OpenBook(CheckersBook *book, const char *path)
+{
+	size_t size;
+	const void *mapping = MF_Map(path, &size);
+
+	memset(book, 0, sizeof(*book));
+	if (!mapping)
+		return -1;
+	if (CK_AttachBook(book, mapping, size) != 0) {
+		MF_Unmap(mapping, size);
+		return -1;
+	}
+	book->mapping = mapping;
+	return 0;
+}
+
+void CK_CloseBook(CheckersBook *book)
+{
+	if (book->mapping)
+		MF_Unmap(book->mapping, book->size);
+	memset(book, 0, sizeof(*book));
+}
+
+int CK_ProbeBook(const CheckersBook *book, const CheckersPosition *pos, unsigned int random, CheckersMove *move)
+{
+	CheckersMoveList list;
+	const unsigned char *entry;
+	unsigned long low = 0, high = book->count, first, chosen;
+	unsigned long total = 0;
+
+	// First entry with this key.
+	while (low < high) {
+		unsigned long middle = low + (high - low) / 2;
+
+		if (ReadWord(book->entries + middle * ENTRYSIZE, 8) < pos->hash)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	first = low;
+	for (high = first; high < book->count && ReadWord(book->entries + high * ENTRYSIZE, 8) == pos->hash; high++)
+		total += ReadWord(book->entries + high * ENTRYSIZE + 14, 2);
+	if (total == 0)
+		return 0;
+
+	random %= total;
+	for (chosen = first; random >= ReadWord(book->entries + chosen * ENTRYSIZE + 14, 2); chosen++)
+		random -= (unsigned int)ReadWord(book->entries + chosen * ENTRYSIZE + 14, 2);
+	entry = book->entries + chosen * ENTRYSIZE;
+
+	// Keys can collide, so only a reply that's legal here counts.
+	CK_GenerateMoves(pos, &list);
+	for (int i = 0; i < list.count; i++) {
+		if (list.moves[i].from == entry[12] && list.moves[i].to == entry[13] && list.moves[i].captured == (unsigned int)ReadWord(entry + 8, 4)) {
+			*move = list.moves[i];
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,57 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersBook.h
+//# Opening book for Checkers: replies to known positions, each
+//# with a weight, looked up by Zobrist key in a memory-mapped
+//# file (or any other block of memory).
+//#
+//# File layout, little endian:
+//#   16 byte header: "PCBK", version, 3 reserved, entry count (4 bytes), 4 reserved
+//#   entry count * 16 byte entries, sorted by key:
+//#     key (8 bytes), captured squares (4 bytes), from, to, weight (2 bytes)
+//# A position with several replies has one entry for each.
+//###############################################################
+#pragma once
+#include "CheckersEngine.h"
+
+#include <stddef.h>
+
+#define CK_BOOK_VERSION 1
+
+typedef struct
+{
+	const unsigned char *entries;
+	unsigned long count;
+	size_t size;
+
+	const void *mapping; // set when CK_OpenBook mapped the file
+} CheckersBook;
+
+// Maps a book file read-only.  Returns 0 on success, -1 if it can't be opened or
+// isn't a book, or if this platform can't map files.
+int CK_OpenBook(CheckersBook *book, const char *path);
+void CK_CloseBook(CheckersBook *book);
+
+// Uses a book that's already in memory.  Same return values.
+int CK_AttachBook(CheckersBook *book, const void *data, size_t size);
+
+// Picks one of the book's replies to pos, in proportion to their weights, using
+// random to choose.  Returns 1 and the full legal move, or 0 if the book has none.
+int CK_ProbeBook(const CheckersBook *book, const CheckersPosition *pos, unsigned int random, CheckersMove *move);
@@ -0,0 +1,384 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersEngine.c
+//# Move generation for English checkers.  Plain steps come
+//# straight out of shifts on the whole bitboard, jumps are
+//# followed square by square to the end of the chain.
+//###############################################################
+#include "CheckersEngine.h"
+
+#define EVENROWS 0x0F0F0F0Fu  // rows 0, 2, 4 and 6, whose dark squares are at odd x
+#define ODDROWS 0xF0F0F0F0u
+#define LEFTEDGE 0x10101010u  // x == 0
+#define RIGHTEDGE 0x08080808u // x == 7
+
+// Zobrist keys for each kind of piece (side * 2 + king) on each square, and for side 1 to move.
+static const unsigned long long m_zobrist[CK_SIDES * 2][CK_SQUARES] =
+{
+{
+		0x2B8A1965FE6061F0ull, 0x53C9D2DCE0E6E709ull, 0x91BD6C0416ADACB1ull, 0x991A8D4775AAD5FEull,
+		0x289191890AB35000ull, 0xD63FA0AF7FCC8663ull, 0x7D8593A9BD1B49C7ull, 0xA32B6BCC8DD21E41ull,
+		0xB0E870B71E36AFEBull, 0x21E916F36D5733ECull, 0xFB48134716139DAFull, 0x1CA6C40F5157C879ull,
+		0x030D7227AB72B0D8ull, 0xA074367F59A9B577ull, 0xD7BC8D5B87BF4687ull, 0xD9355179A2176628ull,
+		0xA4831C36B48B74F3ull, 0x5022DC63F97DAFA7ull, 0x5A0086E59C234530ull, 0xF7ACA912D3F53C1Aull,
+		0xA7A149A478F706D5ull, 0x8BE0F18E19FDB286ull, 0xDA196574A03C8DD1ull, 0xAAE1F0C3EB3FFE7Bull,
+		0xF9364446E897C5D4ull, 0x174252FDE88D5545ull, 0x961E6352B97018FDull, 0xE612BA0DA0673047ull,
+		0x1DDF8475E174643Bull, 0xC60FD810F58733BAull, 0x8FE898EEA026B6A5ull, 0xAC09D35BB4A14A3Cull,
+	},
+	{
+		0xAC9B825630F3A2CAull, 0xAAE946183E480CA1ull, 0x36276254A611ABEDull, 0x72371E769C7E6C4Bull,
+		0xB09B28F885211078ull, 0xA53DAFA7A07311E3ull, 0xD4B2EE7465A15EAEull, 0x94E335FAD433F714ull,
+		0x202A5CDA9058C86Aull, 0xED53FA8D7DC7198Dull, 0x6A716C75AC85EDC3ull, 0x79487D2D02EAE91Eull,
+		0x33928E97B6CEF18Full, 0xF8E31F3BE6F1BDAAull, 0xFB8C6819E9C7211Bull, 0xD7BA0CC7702ACE3Eull,
+		0xDFC700520F8C9E15ull, 0x8566E7DB95ED7D5Cull, 0xC15932A0429729ADull, 0xB8AFCB6A4880AFCAull,
+		0xB2317B3C5F506A23ull, 0x9EFB479D66B11872ull, 0xDC2ECD4CC934B576ull, 0x5DACCEDC5CC28089ull,
+		0xA6BD13436B35B2D5ull, 0x42928C99556C1CC6ull, 0xC2D05B3530C96E24ull, 0xE828847C72E05DB9ull,
+		0x9B7A3CEA4526AD62ull, 0xEF1C3E4B210A72A8ull, 0xA1BBA85EE43F558Aull, 0x2E5D464D8EE8F2E5ull,
+	},
+	{
+		0xEF4D6B04D6405379ull, 0x72564ACADEA5C46Bull, 0x13134AED7F99C4B2ull, 0x957711653E0030FBull,
+		0x097598BDE6CE98EEull, 0xEF757418F20DFC61ull, 0xE0FA36BFBDBC4CCEull, 0xC82716A1438B52F4ull,
+		0x912C930FB7CFD491ull, 0xCA47A1EDB074B437ull, 0xCFB75D1D39E349DFull, 0xA19CF0E084BC4565ull,
+		0xCC3725D512BAD169ull, 0x4810C3A6AA73522Eull, 0xD8C3A5F8A5EC3CB3ull, 0x50B0D1F6B61CBC83ull,
+		0xC0843262EC6FAE44ull, 0x48C5EF7F691AB951ull, 0x0F007D1CB8A0C98Bull, 0xBA677F0237CE1793ull,
+		0x1F056FF02BA611C3ull, 0x173C04E728A0F932ull, 0xD754B4200196AA3Bull, 0xFC2535B062D2BA67ull,
+		0x819AA56419E88B22ull, 0xEBF9EBCC9A050FF6ull, 0x349327184AD087EEull, 0xFA3843CBAEECB60Dull,
+		0xC7B159F58F893AD3ull, 0xBDDD3EF21C5C249Eull, 0x0EE6B48DB7C78602ull, 0x56A61E093E8688CFull,
+	},
+	{
+		0xE70EA15FFA04D5E8ull, 0x9CA5B31BA715E92Dull, 0xDCD20618ADF7D652ull, 0x2035B58DAC79E43Bull,
+		0x3B3625F874EEFCC2ull, 0x769E6CFBC3C1FF1Full, 0x8F115C8C4B72D816ull, 0x6BAB59F68B0C7162ull,
+		0x62546E1FE4C5F675ull, 0xDD0F083E792E0D58ull, 0xB7E29136256A7D72ull, 0xB7238522D718F6AEull,
+		0x239E8AF91BD5ACDDull, 0xE4FC782E9B1B80FCull, 0x91AE6C0B0B8A7125ull, 0xC3FDDF05E1238B5Aull,
+		0xCE356B8C88288526ull, 0x737FBDCBC7415115ull, 0x9E851DA27EF1C731ull, 0x2C2AC44DD350DE4Dull,
+		0xEFEB7657C1ED35B8ull, 0xECCC185D6C29B0EFull, 0x0227E534E1D88F59ull, 0x0B7AD0C6FEF1383Aull,
+		0x7068C9E9C9A4E450ull, 0x3BE9F0161B25A560ull, 0x33EA81DAA45449B8ull, 0xD98687F12B444F77ull,
+		0x507CCD480BF6DC9Dull, 0xC134DC43EFD356FBull, 0x072BEF55699C9CA0ull, 0x8F97922A8739AD45ull,
+	},
+};
+static const unsigned long long m_zobristSide = 0x393F72C35C1BE213ull;
+
+// Rows a man is crowned on, by side.
+static const unsigned int m_crownRow[CK_SIDES] = { 0x0000000Fu, 0xF0000000u };
+
+// Diagonal directions.  Up is towards row 0, the way side 0 moves.
+#define DIR_UPLEFT 0
+#define DIR_UPRIGHT 1
+#define DIR_DOWNLEFT 2
+#define DIR_DOWNRIGHT 3
+
+// Moves every piece in bb one square in a direction.  Pieces that would go off the board vanish.
+static unsigned int UpLeft(unsigned int bb)    { return ((bb & EVENROWS) >> 4) | ((bb & ODDROWS & ~LEFTEDGE) >> 5); }
+static unsigned int UpRight(unsigned int bb)   { return ((bb & EVENROWS & ~RIGHTEDGE) >> 3) | ((bb & ODDROWS) >> 4); }
+static unsigned int DownLeft(unsigned int bb)  { return ((bb & EVENROWS) << 4) | ((bb & ODDROWS & ~LEFTEDGE) << 3); }
+static unsigned int DownRight(unsigned int bb) { return ((bb & EVENROWS & ~RIGHTEDGE) << 5) | ((bb & ODDROWS) << 4); }
+
+static unsigned int Step(unsigned int bb, int dir)
+{
+	switch (dir) {
+	case DIR_UPLEFT: return UpLeft(bb);
+	case DIR_UPRIGHT: return UpRight(bb);
+	case DIR_DOWNLEFT: return DownLeft(bb);
+	default: return DownRight(bb);
+	}
+}
+
+// The direction that undoes dir.
+static int Reverse(int dir)
+{
+	return 3 - dir;
+}
+
+// Men of side 0 only go up and men of side 1 only go down.
+static int MayGo(int side, int king, int dir)
+{
+	if (king)
+		return 1;
+
+	return side == 0 ? dir <= DIR_UPRIGHT : dir >= DIR_DOWNLEFT;
+}
+
+int CK_Square(int x, int y)
+{
+	if (x < 0 || y < 0 || x >= 8 || y >= 8 || (x + y) % 2 == 0)
+		return -1;
+
+	return y * 4 + x / 2;
+}
+
+int CK_SquareX(int s)
+{
+	return (s & 3) * 2 + ((s >> 2) % 2 == 0);
+}
+
+int CK_SquareY(int s)
+{
+	return s >> 2;
+}
+
+// Key of whatever is on square s, 0 if it's empty.
+static unsigned long long SquareKey(const CheckersPosition *pos, int s)
+{
+	unsigned int bit = 1u << s;
+	int king = (pos->kings & bit) != 0;
+
+	if (pos->pieces[0] & bit)
+		return m_zobrist[king][s];
+	if (pos->pieces[1] & bit)
+		return m_zobrist[2 + king][s];
+	return 0;
+}
+
+void CK_Clear(CheckersPosition *pos)
+{
+	pos->pieces[0] = pos->pieces[1] = 0;
+	pos->kings = 0;
+	pos->side = 0;
+	pos->hash = 0;
+}
+
+void CK_SetStartPosition(CheckersPosition *pos)
+{
+	CK_Clear(pos);
+
+	for (int s = 0; s < 12; s++) {
+		CK_PutPiece(pos, s, 1, 0);      // rows 0 to 2
+		CK_PutPiece(pos, s + 20, 0, 0); // rows 5 to 7
+	}
+}
+
+void CK_PutPiece(CheckersPosition *pos, int s, int side, int king)
+{
+	unsigned int bit = 1u << s;
+
+	CK_RemovePiece(pos, s);
+	pos->pieces[side] |= bit;
+	if (king)
+		pos->kings |= bit;
+	pos->hash ^= m_zobrist[side * 2 + (king != 0)][s];
+}
+
+void CK_RemovePiece(CheckersPosition *pos, int s)
+{
+	unsigned int bit = 1u << s;
+
+	pos->hash ^= SquareKey(pos, s);
+	pos->pieces[0] &= ~bit;
+	pos->pieces[1] &= ~bit;
+	pos->kings &= ~bit;
+}
+
+void CK_SetSide(CheckersPosition *pos, int side)
+{
+	if (pos->side != side)
+		pos->hash ^= m_zobristSide;
+	pos->side = side;
+}
+
+unsigned int CK_Movers(const CheckersPosition *pos)
+{
+	unsigned int own = pos->pieces[pos->side], empty = ~(pos->pieces[0] | pos->pieces[1]);
+	unsigned int up = DownLeft(empty) | DownRight(empty);  // squares with an empty square up from them
+	unsigned int down = UpLeft(empty) | UpRight(empty);
+
+	if (pos->side == 0)
+		return (own & up) | (own & pos->kings & down);
+
+	return (own & down) | (own & pos->kings & up);
+}
+
+unsigned int CK_Jumpers(const CheckersPosition *pos)
+{
+	unsigned int own = pos->pieces[pos->side], enemy = pos->pieces[!pos->side];
+	unsigned int empty = ~(pos->pieces[0] | pos->pieces[1]);
+	unsigned int up = DownLeft(DownLeft(empty) & enemy) | DownRight(DownRight(empty) & enemy);
+	unsigned int down = UpLeft(UpLeft(empty) & enemy) | UpRight(UpRight(empty) & enemy);
+
+	if (pos->side == 0)
+		return (own & up) | (own & pos->kings & down);
+
+	return (own & down) | (own & pos->kings & up);
+}
+
+static void AddMove(CheckersMoveList *list, const CheckersMove *move)
+{
+	// A king can sometimes take the same pieces by two routes.  That's still one move.
+	if (move->hops > 1) {
+		for (int i = 0; i < list->count; i++) {
+			const CheckersMove *other = &list->moves[i];
+
+			if (other->from == move->from && other->to == move->to && other->captured == move->captured)
+				return;
+		}
+	}
+
+	if (list->count < CK_MAXMOVES)
+		list->moves[list->count++] = *move;
+}
+
+// Follows a jump from s in every direction it can continue, adding each chain that ends.
+static void ExtendJump(CheckersMoveList *list, CheckersMove *move, int s, int side, int king, unsigned int enemy, unsigned int empty)
+{
+	unsigned int bit = 1u << s;
+	int bExtended = 0;
+
+	for (int dir = 0; dir < 4; dir++) {
+		unsigned int over, land;
+
+		if (!MayGo(side, king, dir))
+			continue;
+
+		over = Step(bit, dir) & enemy;
+		land = Step(over, dir) & empty;
+		if (!land)
+			continue;
+
+		// Jumped pieces come off straight away, as they do on the table.
+		move->captured |= over;
+		move->path[++move->hops] = (unsigned char)CK_Lowest(land);
+		ExtendJump(list, move, move->path[move->hops], side, king || (land & m_crownRow[side]),
+			enemy & ~over, (empty | over | bit) & ~land);
+		move->hops--;
+		move->captured &= ~over;
+
+		bExtended = 1;
+	}
+
+	if (!bExtended && move->hops > 0) {
+		move->to = (unsigned char)s;
+		AddMove(list, move);
+	}
+}
+
+static void AddCapturesFrom(const CheckersPosition *pos, int s, CheckersMoveList *list)
+{
+	CheckersMove move;
+
+	move.from = move.to = (unsigned char)s;
+	move.hops = 0;
+	move.path[0] = (unsigned char)s;
+	move.captured = 0;
+
+	ExtendJump(list, &move, s, pos->side, (pos->kings >> s) & 1, pos->pieces[!pos->side],
+		~(pos->pieces[0] | pos->pieces[1]));
+}
+
+int CK_GenerateCapturesFrom(const CheckersPosition *pos, int s, CheckersMoveList *list)
+{
+	list->count = 0;
+	AddCapturesFrom(pos, s, list);
+	return list->count;
+}
+
+int CK_GenerateMoves(const CheckersPosition *pos, CheckersMoveList *list)
+{
+	unsigned int own = pos->pieces[pos->side];
+	unsigned int empty = ~(pos->pieces[0] | pos->pieces[1]);
+	unsigned int jumpers = CK_Jumpers(pos);
+
+	list->count = 0;
+
+	if (jumpers) {
+		for (; jumpers; jumpers &= jumpers - 1)
+			AddCapturesFrom(pos, CK_Lowest(jumpers), list);
+		return list->count;
+	}
+
+	for (int dir = 0; dir < 4; dir++) {
+		// Everything that can step this way, found by stepping the empty squares back.
+		unsigned int movers = Step(empty, Reverse(dir)) & own;
+
+		if (!MayGo(pos->side, 0, dir))
+			movers &= pos->kings;
+
+		for (; movers; movers &= movers - 1) {
+			CheckersMove *move = &list->moves[list->count++];
+			int from = CK_Lowest(movers);
+
+			move->from = move->path[0] = (unsigned char)from;
+			move->to = move->path[1] = (unsigned char)CK_Lowest(Step(1u << from, dir));
+			move->hops = 0;
+			move->captured = 0;
+		}
+	}
+
+	return list->count;
+}
+
+void CK_MakeMove(CheckersPosition *pos, const CheckersMove *move)
+{
+	unsigned int from = 1u << move->from, to = 1u << move->to;
+	int side = pos->side;
+	int king = (pos->kings & from) != 0;
+
+	pos->hash ^= m_zobrist[side * 2 + king][move->from] ^ m_zobristSide;
+	for (unsigned int captured = move->captured; captured; captured &= captured - 1)
+		pos->hash ^= SquareKey(pos, CK_Lowest(captured));
+
+	pos->pieces[side] &= ~from;
+	pos->kings &= ~from;
+	pos->pieces[!side] &= ~move->captured;
+	pos->kings &= ~move->captured;
+
+	// Crowned if any square it landed on was on the far row, even mid-jump.
+	for (int i = 1; i <= move->hops || i == 1; i++) {
+		if ((1u << move->path[i]) & m_crownRow[side])
+			king = 1;
+	}
+
+	pos->pieces[side] |= to;
+	if (king)
+		pos->kings |= to;
+	pos->hash ^= m_zobrist[side * 2 + king][move->to];
+	pos->side = !side;
+}
+
+int CK_IsReversible(const CheckersPosition *pos, const CheckersMove *move)
+{
+	return move->hops == 0 && ((pos->kings >> move->from) & 1);
+}
+
+void CK_ResetHistory(CheckersHistory *history, const CheckersPosition *pos)
+{
+	history->keys[0] = pos->hash;
+	history->count = 1;
+}
+
+int CK_RecordPosition(CheckersHistory *history, const CheckersPosition *pos, int bReversible)
+{
+	int seen = 1;
+
+	if (!bReversible) {
+		CK_ResetHistory(history, pos);
+		return 0;
+	}
+
+	if (history->count > CK_DRAWPLIES)
+		return 1;
+
+	// Only positions with the same side to move can match.
+	for (int i = history->count - 2; i >= 0; i -= 2) {
+		if (history->keys[i] == pos->hash)
+			seen++;
+	}
+
+	history->keys[history->count++] = pos->hash;
+	return seen >= CK_REPETITIONS || history->count > CK_DRAWPLIES;
+}
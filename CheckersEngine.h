@@ -0,0 +1,140 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersEngine.h
+//# Checkers rules on 32-square bitboards.  Knows nothing about
+//# colours or LEDs, so the game, the AI and the host tools can
+//# all share it.
+//###############################################################
+#pragma once
+
+// Only the dark squares are playable, so square s is bit s: four per row,
+// row y holds squares 4y to 4y+3.  See CK_Square for the mapping to (x, y).
+//
+// Side 0 is player 1 (red), who starts on rows 5-7 and moves towards row 0.
+// Side 1 is player 2 (blue), who starts on rows 0-2 and moves towards row 7.
+#define CK_SQUARES 32
+#define CK_SIDES 2
+
+// Captures are compulsory and a jump must be carried on as long as it can.
+// A man that reaches the far row mid-jump is crowned and keeps jumping as a
+// king, the same as MovePiece has always played it.  Each hop needs an enemy
+// piece that is still on the board, so a chain can't exceed the 12 pieces.
+#define CK_MAXHOPS 12
+#define CK_MAXMOVES 128
+
+typedef struct
+{
+	unsigned int pieces[CK_SIDES]; // every piece each side has
+	unsigned int kings;            // which of those are kings
+	int side;                      // side to move
+	unsigned long long hash;       // Zobrist key of all the above, kept up to date by every function here
+} CheckersPosition;
+
+typedef struct
+{
+	unsigned char from, to;
+	unsigned char hops;                   // pieces captured, 0 for a plain step
+	unsigned char path[CK_MAXHOPS + 1];   // from, each landing square, to
+	unsigned int captured;                // squares of the captured pieces
+} CheckersMove;
+
+typedef struct
+{
+	int count;
+	CheckersMove moves[CK_MAXMOVES];
+} CheckersMoveList;
+
+// A game is drawn when a position comes up for the third time, or when 40 moves
+// each go by without a capture or a man moving.  Only king steps can repeat a
+// position, so just the keys since the last of anything else are kept.
+#define CK_REPETITIONS 3
+#define CK_DRAWPLIES 80
+
+typedef struct
+{
+	unsigned long long keys[CK_DRAWPLIES + 1]; // keys[0] is the position after the last capture or man move
+	int count;
+} CheckersHistory;
+
+// Bit twiddling shared with the other checkers modules.
+static inline int CK_Count(unsigned int bb)
+{
+#if defined(__GNUC__)
+	return __builtin_popcount(bb);
+#else
+	int count = 0;
+
+	for (; bb; bb &= bb - 1)
+		count++;
+	return count;
+#endif
+}
+
+// Index of the lowest set bit.  bb must not be 0.
+static inline int CK_Lowest(unsigned int bb)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(bb);
+#else
+	int s = 0;
+
+	while (!(bb & 1)) {
+		bb >>= 1;
+		s++;
+	}
+	return s;
+#endif
+}
+
+// Board coordinates as Checkers.c uses them.  CK_Square returns -1 for light squares and anything off the board.
+int CK_Square(int x, int y);
+int CK_SquareX(int s);
+int CK_SquareY(int s);
+
+void CK_SetStartPosition(CheckersPosition *pos);
+void CK_Clear(CheckersPosition *pos);
+void CK_PutPiece(CheckersPosition *pos, int s, int side, int king);
+void CK_RemovePiece(CheckersPosition *pos, int s);
+void CK_SetSide(CheckersPosition *pos, int side);
+
+// Pieces of the side to move that can step or jump.
+unsigned int CK_Movers(const CheckersPosition *pos);
+unsigned int CK_Jumpers(const CheckersPosition *pos);
+
+// Every legal move for the side to move: the complete jumps if there are any,
+// otherwise the plain steps.  Returns the number of moves.
+int CK_GenerateMoves(const CheckersPosition *pos, CheckersMoveList *list);
+
+// Just the complete jumps the piece on s can make.  Used mid-chain, when the
+// pieces already jumped have gone and the piece may have been crowned.
+int CK_GenerateCapturesFrom(const CheckersPosition *pos, int s, CheckersMoveList *list);
+
+// Plays a move from one of the lists above and passes the turn.
+void CK_MakeMove(CheckersPosition *pos, const CheckersMove *move);
+
+// Whether a move could ever be undone by later moves: a king step that takes nothing.
+int CK_IsReversible(const CheckersPosition *pos, const CheckersMove *move);
+
+// Starts the history off at pos.
+void CK_ResetHistory(CheckersHistory *history, const CheckersPosition *pos);
+
+// Adds the position reached by a move, bReversible as from CK_IsReversible.
+// Returns 1 if the game is now drawn.
+int CK_RecordPosition(CheckersHistory *history, const CheckersPosition *pos, int bReversible);
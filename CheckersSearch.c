@@ -0,0 +1,372 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersSearch.c
+//# Negamax alpha-beta with iterative deepening.  Moves are tried
+//# best-first from the last iteration, then killers, then by
+//# history.  Leaves keep searching while a capture is pending,
+//# since a capture can't be declined anyway.  Any repeat of an
+//# earlier position scores as a draw, and positions in the
+//# endgame tables score as the tables say.
+//###############################################################
+#include "CheckersSearch.h"
+
+#include <string.h>
+
+#define MAN_VALUE 100
+#define KING_VALUE 150
+
+#define BACKROW_0 0xF0000000u // side 0's home row, which stops side 1 crowning
+#define BACKROW_1 0x0000000Fu
+#define CENTRE 0x00666600u    // the middle four squares of rows 2 to 5
+
+typedef struct
+{
+	CheckersSearchLimits limits;
+	unsigned long nodes;
+	int bAborted;
+
+	// Keys of the game's reversible tail followed by the current search path.
+	unsigned long long keys[CK_DRAWPLIES + 1 + CK_MAXPLY];
+	int rootIndex;
+
+	CheckersMove killers[CK_MAXPLY][2];
+	unsigned int history[CK_SQUARES][CK_SQUARES];
+} Searcher;
+
+static int SameMove(const CheckersMove *a, const CheckersMove *b)
+{
+	return a->from == b->from && a->to == b->to && a->captured == b->captured;
+}
+
+void CK_InitTT(CheckersTT *tt, CheckersTTEntry *entries, unsigned long count)
+{
+	tt->entries = entries;
+	tt->mask = count - 1;
+	tt->age = 0;
+	memset(entries, 0, count * sizeof(CheckersTTEntry));
+}
+
+static CheckersTTEntry *ProbeTT(CheckersTT *tt, unsigned long long key)
+{
+	CheckersTTEntry *pair = &tt->entries[key & tt->mask & ~1ul];
+
+	if (pair[0].bound && pair[0].key == key)
+		return &pair[0];
+	if (pair[1].bound && pair[1].key == key)
+		return &pair[1];
+	return 0;
+}
+
+static void StoreTT(CheckersTT *tt, unsigned long long key, int depth, int score, int bound, const CheckersMove *best, int ply)
+{
+	CheckersTTEntry *pair = &tt->entries[key & tt->mask & ~1ul];
+	CheckersTTEntry *entry = &pair[1];
+
+	if (pair[0].key == key || pair[0].age != tt->age || pair[0].depth <= depth)
+		entry = &pair[0];
+
+	// Wins and losses are stored as distance from this position rather than from the root.
+	if (score > CK_WIN - CK_MAXPLY)
+		score += ply;
+	else if (score < -CK_WIN + CK_MAXPLY)
+		score -= ply;
+
+	entry->key = key;
+	entry->score = (short)score;
+	entry->depth = (unsigned char)depth;
+	entry->bound = (unsigned char)bound;
+	entry->age = tt->age;
+	entry->from = best ? best->from : 0;
+	entry->to = best ? best->to : 0;
+	entry->captured = best ? best->captured : 0;
+}
+
+static int TTScore(const CheckersTTEntry *entry, int ply)
+{
+	if (entry->score > CK_WIN - CK_MAXPLY)
+		return entry->score - ply;
+	if (entry->score < -CK_WIN + CK_MAXPLY)
+		return entry->score + ply;
+	return entry->score;
+}
+
+// Whether the position at ply has been seen before within the last run reversible plies.
+static int IsRepetition(Searcher *s, unsigned long long key, int ply, int run)
+{
+	int index = s->rootIndex + ply;
+
+	s->keys[index] = key;
+	if (run >= CK_DRAWPLIES)
+		return 1;
+
+	for (int i = index - 2; i >= index - run && i >= 0; i -= 2) {
+		if (s->keys[i] == key)
+			return 1;
+	}
+
+	return 0;
+}
+
+// Rows a man of side 0 has come up the board, summed over all of them.
+static int Advancement(unsigned int men, int side)
+{
+	int total = 0;
+
+	for (int row = 0; row < 8; row++) {
+		int count = CK_Count(men & (0xFu << (row * 4)));
+
+		total += count * (side == 0 ? 7 - row : row);
+	}
+
+	return total;
+}
+
+int CK_Evaluate(const CheckersPosition *pos)
+{
+	int score[CK_SIDES];
+	unsigned int backRow[CK_SIDES] = { BACKROW_0, BACKROW_1 };
+
+	for (int side = 0; side < CK_SIDES; side++) {
+		unsigned int men = pos->pieces[side] & ~pos->kings;
+		unsigned int kings = pos->pieces[side] & pos->kings;
+
+		score[side] = CK_Count(men) * MAN_VALUE + CK_Count(kings) * KING_VALUE;
+		score[side] += Advancement(men, side) * 3;
+		score[side] += CK_Count(men & backRow[side]) * 8;
+		score[side] += CK_Count(kings & CENTRE) * 10;
+	}
+
+	return score[pos->side] - score[!pos->side];
+}
+
+static int Aborted(Searcher *s)
+{
+	if (s->limits.maxNodes && s->nodes >= s->limits.maxNodes)
+		s->bAborted = 1;
+
+	return s->bAborted;
+}
+
+// Gives each move an ordering score, biggest first.
+static void ScoreMoves(Searcher *s, const CheckersMoveList *list, int *scores, int ply, const CheckersMove *first)
+{
+	for (int i = 0; i < list->count; i++) {
+		const CheckersMove *move = &list->moves[i];
+
+		if (first && SameMove(move, first))
+			scores[i] = 1 << 30;
+		else if (move->hops)
+			scores[i] = (1 << 24) + move->hops;
+		else if (SameMove(move, &s->killers[ply][0]))
+			scores[i] = (1 << 23) + 1;
+		else if (SameMove(move, &s->killers[ply][1]))
+			scores[i] = 1 << 23;
+		else
+			scores[i] = (int)(s->history[move->from][move->to] & 0x7FFFFF);
+	}
+}
+
+// Swaps the best remaining move into slot i.
+static void PickMove(CheckersMoveList *list, int *scores, int i)
+{
+	int best = i;
+
+	for (int j = i + 1; j < list->count; j++) {
+		if (scores[j] > scores[best])
+			best = j;
+	}
+
+	if (best != i) {
+		CheckersMove move = list->moves[i];
+		int score = scores[i];
+
+		list->moves[i] = list->moves[best];
+		scores[i] = scores[best];
+		list->moves[best] = move;
+		scores[best] = score;
+	}
+}
+
+static void RememberCutoff(Searcher *s, const CheckersMove *move, int ply, int depth)
+{
+	if (move->hops)
+		return;
+
+	if (!SameMove(move, &s->killers[ply][0])) {
+		s->killers[ply][1] = s->killers[ply][0];
+		s->killers[ply][0] = *move;
+	}
+	s->history[move->from][move->to] += depth * depth;
+}
+
+// run is how many reversible plies led up to pos.
+static int AlphaBeta(Searcher *s, const CheckersPosition *pos, int depth, int alpha, int beta, int ply, int run)
+{
+	CheckersMoveList list;
+	CheckersMove ttMove, *pTTMove = 0;
+	int scores[CK_MAXMOVES];
+	int best = -CK_INFINITY, bestIndex = -1, alphaIn = alpha;
+
+	s->nodes++;
+	if (Aborted(s))
+		return 0;
+
+	if (IsRepetition(s, pos->hash, ply, run))
+		return 0;
+
+	// A table hit is the exact answer.
+	if (s->limits.tablebase) {
+		int plies, result = CK_ProbeTablebase(s->limits.tablebase, pos, &plies);
+
+		if (result == CK_TB_WIN)
+			return CK_WIN - ply - plies;
+		if (result == CK_TB_LOSS)
+			return -CK_WIN + ply + plies;
+		if (result == CK_TB_DRAWN)
+			return 0;
+	}
+
+	if (s->limits.tt) {
+		CheckersTTEntry *entry = ProbeTT(s->limits.tt, pos->hash);
+
+		if (entry) {
+			int score = TTScore(entry, ply);
+
+			if (entry->depth >= depth && depth > 0) {
+				if (entry->bound == CK_TT_EXACT ||
+					(entry->bound == CK_TT_LOWER && score >= beta) ||
+					(entry->bound == CK_TT_UPPER && score <= alpha))
+					return score;
+			}
+
+			ttMove.from = entry->from;
+			ttMove.to = entry->to;
+			ttMove.captured = entry->captured;
+			pTTMove = &ttMove;
+		}
+	}
+
+	CK_GenerateMoves(pos, &list);
+	if (list.count == 0)
+		return -CK_WIN + ply;
+
+	// Out of depth with nothing to capture: the position is quiet enough to score.
+	if ((depth <= 0 && list.moves[0].hops == 0) || ply >= CK_MAXPLY - 1)
+		return CK_Evaluate(pos);
+
+	ScoreMoves(s, &list, scores, ply, pTTMove);
+	for (int i = 0; i < list.count; i++) {
+		CheckersPosition next = *pos;
+		int score;
+
+		PickMove(&list, scores, i);
+		CK_MakeMove(&next, &list.moves[i]);
+		score = -AlphaBeta(s, &next, depth - 1, -beta, -alpha, ply + 1,
+			CK_IsReversible(pos, &list.moves[i]) ? run + 1 : 0);
+		if (s->bAborted)
+			return 0;
+
+		if (score > best) {
+			best = score;
+			bestIndex = i;
+		}
+		if (score > alpha)
+			alpha = score;
+		if (alpha >= beta) {
+			RememberCutoff(s, &list.moves[i], ply, depth);
+			break;
+		}
+	}
+
+	if (s->limits.tt && depth > 0) {
+		int bound = best >= beta ? CK_TT_LOWER : best > alphaIn ? CK_TT_EXACT : CK_TT_UPPER;
+
+		StoreTT(s->limits.tt, pos->hash, depth, best, bound, &list.moves[bestIndex], ply);
+	}
+
+	return best;
+}
+
+int CK_Search(const CheckersPosition *pos, const CheckersSearchLimits *limits, CheckersSearchResult *result)
+{
+	Searcher s;
+	CheckersMoveList list;
+	int scores[CK_MAXMOVES];
+	int maxDepth = limits->maxDepth > 0 && limits->maxDepth < CK_MAXDEPTH ? limits->maxDepth : CK_MAXDEPTH;
+
+	memset(&s, 0, sizeof(s));
+	s.limits = *limits;
+	memset(result, 0, sizeof(*result));
+
+	// The root sits at the end of the game's reversible tail.
+	if (limits->history && limits->history->count > 0) {
+		s.rootIndex = limits->history->count - 1;
+		memcpy(s.keys, limits->history->keys, limits->history->count * sizeof(s.keys[0]));
+	}
+	s.keys[s.rootIndex] = pos->hash;
+
+	if (limits->tt)
+		limits->tt->age++;
+
+	if (CK_GenerateMoves(pos, &list) == 0)
+		return 0;
+
+	result->best = list.moves[0];
+	if (list.count == 1)
+		return 1;
+
+	for (int depth = 1; depth <= maxDepth; depth++) {
+		CheckersMove best = result->best;
+		int alpha = -CK_INFINITY;
+
+		ScoreMoves(&s, &list, scores, 0, &result->best);
+		for (int i = 0; i < list.count; i++) {
+			CheckersPosition next = *pos;
+			int score;
+
+			PickMove(&list, scores, i);
+			CK_MakeMove(&next, &list.moves[i]);
+			score = -AlphaBeta(&s, &next, depth - 1, -CK_INFINITY, -alpha, 1,
+				CK_IsReversible(pos, &list.moves[i]) ? s.rootIndex + 1 : 0);
+			if (s.bAborted)
+				break;
+
+			if (score > alpha) {
+				alpha = score;
+				best = list.moves[i];
+			}
+		}
+
+		// A cut-short iteration is thrown away, apart from the first.
+		if (s.bAborted && depth > 1)
+			break;
+
+		result->best = best;
+		result->score = alpha;
+		result->depth = depth;
+
+		// No point looking further once a forced win or loss has been found.
+		if (s.bAborted || alpha > CK_WIN - CK_MAXPLY || alpha < -CK_WIN + CK_MAXPLY)
+			break;
+	}
+
+	result->nodes = s.nodes;
+	return 1;
+}
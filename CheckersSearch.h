@@ -0,0 +1,87 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersSearch.h
+//# Computer opponent for Checkers: iterative-deepening
+//# alpha-beta over CheckersEngine positions.
+//###############################################################
+#pragma once
+#include "CheckersEngine.h"
+#include "CheckersTablebase.h"
+
+#define CK_INFINITY 32000
+#define CK_WIN 30000    // score for a win right now, less one per ply it takes to get there
+#define CK_MAXDEPTH 48
+#define CK_MAXPLY 96    // deepest ply including the capture-only tail
+
+// Transposition table entries.  Scores are either exact or a bound from a cutoff.
+#define CK_TT_EXACT 1
+#define CK_TT_LOWER 2 // the score is at least this
+#define CK_TT_UPPER 3 // the score is at most this
+
+typedef struct
+{
+	unsigned long long key;
+	unsigned int captured; // best move found, as from/to/captured
+	short score;
+	unsigned char from, to;
+	unsigned char depth;
+	unsigned char bound; // 0 for an empty entry
+	unsigned char age;   // the search that wrote it
+} CheckersTTEntry;
+
+// Fixed size, and owned by whoever is searching so every table can have its own.
+// Entries go in pairs: the first keeps the deepest result, unless it's left over
+// from an earlier search, and the second always takes whatever doesn't fit.
+typedef struct
+{
+	CheckersTTEntry *entries;
+	unsigned long mask; // entry count - 1
+	unsigned char age;
+} CheckersTT;
+
+// count must be a power of two, at least 2.  Clears the entries.
+void CK_InitTT(CheckersTT *tt, CheckersTTEntry *entries, unsigned long count);
+
+// The table firmware gives games no clock, so the time a move may take is
+// handed to the search as a node budget.  That also means a search always
+// picks the same move for the same position, which keeps replays exact.
+typedef struct
+{
+	int maxDepth;           // 0 for CK_MAXDEPTH
+	unsigned long maxNodes; // 0 for no limit
+
+	CheckersTT *tt;                  // may be 0
+	const CheckersHistory *history;  // the game so far, to avoid or aim for repetitions.  May be 0.
+	const CheckersTablebase *tablebase; // exact results for positions with few pieces.  May be 0.
+} CheckersSearchLimits;
+
+typedef struct
+{
+	CheckersMove best;
+	int score;           // from the point of view of the side to move
+	int depth;           // deepest iteration that finished
+	unsigned long nodes;
+} CheckersSearchResult;
+
+// Static score of pos for the side to move.
+int CK_Evaluate(const CheckersPosition *pos);
+
+// Finds the best move for the side to move.  Returns 0 if it has no legal move.
+int CK_Search(const CheckersPosition *pos, const CheckersSearchLimits *limits, CheckersSearchResult *result);
@@ -0,0 +1,229 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersTablebase.c
+//# Indexing and probing for the endgame tables.  The tables
+//# themselves are built on the host, see host/CheckersTBGen.c.
+//###############################################################
+#include "CheckersTablebase.h"
+#include "MappedFile.h"
+
+#include <string.h>
+
+#define HEADERSIZE 16
+#define ENTRYSIZE 16
+
+// Men never stand on their own crowning row, so each side's men have 28 squares to choose from.
+#define MANSQUARES 28
+#define REDMANBASE 4  // red men are on squares 4-31
+#define BLUEMANBASE 0 // blue men are on squares 0-27
+
+static unsigned long Choose(int n, int k)
+{
+	unsigned long result = 1;
+	int i;
+
+	if (k < 0 || k > n)
+		return 0;
+	for (i = 1; i <= k; i++)
+		result = result * (n - k + i) / i;
+	return result;
+}
+
+// Rank of a set of squares among all the sets of the same size, counting squares from base.
+static unsigned long Rank(unsigned int bb, int base)
+{
+	unsigned long rank = 0;
+	int i = 1;
+
+	for (; bb; bb &= bb - 1)
+		rank += Choose(CK_Lowest(bb) - base, i++);
+	return rank;
+}
+
+static unsigned int Unrank(unsigned long rank, int count, int base)
+{
+	unsigned int bb = 0;
+	int p = CK_SQUARES;
+
+	for (; count > 0; count--) {
+		do
+			p--;
+		while (Choose(p, count) > rank);
+		rank -= Choose(p, count);
+		bb |= 1u << (p + base);
+	}
+	return bb;
+}
+
+static unsigned int ReadWord(const unsigned char *p, int bytes)
+{
+	unsigned int value = 0;
+
+	while (bytes--)
+		value = (value << 8) | p[bytes];
+	return value;
+}
+
+unsigned long CK_TablebaseSliceSize(int redMen, int redKings, int blueMen, int blueKings)
+{
+	return Choose(MANSQUARES, redMen) * Choose(CK_SQUARES, redKings) * Choose(MANSQUARES, blueMen) * Choose(CK_SQUARES, blueKings) * CK_SIDES;
+}
+
+unsigned long CK_TablebaseIndex(const CheckersPosition *pos)
+{
+	unsigned int redKings = pos->pieces[0] & pos->kings;
+	unsigned int blueKings = pos->pieces[1] & pos->kings;
+	unsigned long index;
+
+	index = Rank(pos->pieces[0] & ~pos->kings, REDMANBASE);
+	index = index * Choose(CK_SQUARES, CK_Count(redKings)) + Rank(redKings, 0);
+	index = index * Choose(MANSQUARES, CK_Count(pos->pieces[1] & ~pos->kings)) + Rank(pos->pieces[1] & ~pos->kings, BLUEMANBASE);
+	index = index * Choose(CK_SQUARES, CK_Count(blueKings)) + Rank(blueKings, 0);
+	return index * CK_SIDES + pos->side;
+}
+
+int CK_TablebasePosition(unsigned long index, int redMen, int redKings, int blueMen, int blueKings, CheckersPosition *pos)
+{
+	unsigned long size;
+	unsigned int groups[4];
+	int side = index % CK_SIDES;
+	int s;
+
+	index /= CK_SIDES;
+	size = Choose(CK_SQUARES, blueKings);
+	groups[3] = Unrank(index % size, blueKings, 0);
+	index /= size;
+	size = Choose(MANSQUARES, blueMen);
+	groups[2] = Unrank(index % size, blueMen, BLUEMANBASE);
+	index /= size;
+	size = Choose(CK_SQUARES, redKings);
+	groups[1] = Unrank(index % size, redKings, 0);
+	index /= size;
+	groups[0] = Unrank(index, redMen, REDMANBASE);
+
+	if (CK_Count(groups[0] | groups[1] | groups[2] | groups[3]) != redMen + redKings + blueMen + blueKings)
+		return 0;
+
+	CK_Clear(pos);
+	for (s = 0; s < CK_SQUARES; s++) {
+		if (groups[0] & (1u << s))
+			CK_PutPiece(pos, s, 0, 0);
+		else if (groups[1] & (1u << s))
+			CK_PutPiece(pos, s, 0, 1);
+		else if (groups[2] & (1u << s))
+			CK_PutPiece(pos, s, 1, 0);
+		else if (groups[3] & (1u << s))
+			CK_PutPiece(pos, s, 1, 1);
+	}
+	CK_SetSide(pos, side);
+	return 1;
+}
+
+int CK_AttachTablebase(CheckersTablebase *tb, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+	int i;
+
+	memset(tb, 0, sizeof(*tb));
+	memset(tb->slices, 0xFF, sizeof(tb->slices));
+	if (size < HEADERSIZE || memcmp(bytes, "PCTB", 4) != 0 || bytes[4] != CK_TB_VERSION || bytes[5] > CK_TB_MAXPIECES)
+		return -1;
+	tb->maxPieces = bytes[5];
+	tb->sliceCount = ReadWord(bytes + 6, 2);
+	if (size < HEADERSIZE + (size_t)tb->sliceCount * ENTRYSIZE)
+		return -1;
+
+	for (i = 0; i < tb->sliceCount; i++) {
+		const unsigned char *entry = bytes + HEADERSIZE + i * ENTRYSIZE;
+		unsigned int offset = ReadWord(entry + 8, 4);
+
+		if (entry[0] + entry[1] + entry[2] + entry[3] > tb->maxPieces || ReadWord(entry + 12, 4) != 0 ||
+			offset > size || size - offset < CK_TablebaseSliceSize(entry[0], entry[1], entry[2], entry[3]))
+			return -1;
+		tb->slices[entry[0]][entry[1]][entry[2]][entry[3]] = (short)i;
+	}
+	tb->data = bytes;
+	tb->size = size;
+	return 0;
+}
+
+int CK_OpenTablebase(CheckersTablebase *tb, const char *path)
+{
+	size_t size;
+	const void *mapping = MF_Map(path, &size);
+
+	memset(tb, 0, sizeof(*tb));
+	if (!mapping)
+		return -1;
+	if (CK_AttachTablebase(tb, mapping, size) != 0) {
+		MF_Unmap(mapping, size);
+		return -1;
+	}
+	tb->mapping = mapping;
+	return 0;
+}
+
+void CK_CloseTablebase(CheckersTablebase *tb)
+{
+	if (tb->mapping)
+		MF_Unmap(tb->mapping, tb->size);
+	memset(tb, 0, sizeof(*tb));
+}
+
+int CK_TablebaseValue(const CheckersTablebase *tb, const CheckersPosition *pos)
+{
+	unsigned int men = pos->pieces[0] & ~pos->kings, enemyMen = pos->pieces[1] & ~pos->kings;
+	int counts[4];
+	int slice;
+
+	if (!tb->data || CK_Count(pos->pieces[0] | pos->pieces[1]) > tb->maxPieces)
+		return -1;
+	// Uncrowned men on the far row only turn up part way through a move.
+	if ((men & 0xFu) || (enemyMen & 0xF0000000u))
+		return -1;
+
+	counts[0] = CK_Count(men);
+	counts[1] = CK_Count(pos->pieces[0] & pos->kings);
+	counts[2] = CK_Count(enemyMen);
+	counts[3] = CK_Count(pos->pieces[1] & pos->kings);
+	slice = tb->slices[counts[0]][counts[1]][counts[2]][counts[3]];
+	if (slice < 0)
+		return -1;
+
+	return tb->data[ReadWord(tb->data + HEADERSIZE + slice * ENTRYSIZE + 8, 4) + CK_TablebaseIndex(pos)];
+}
+
+int CK_ProbeTablebase(const CheckersTablebase *tb, const CheckersPosition *pos, int *plies)
+{
+	int value;
+
+	*plies = 0;
+	// Out of pieces is a loss for the side to move, no table needed.
+	if (!pos->pieces[pos->side])
+		return CK_TB_LOSS;
+
+	value = CK_TablebaseValue(tb, pos);
+	if (value < 0)
+		return CK_TB_UNKNOWN;
+	if (value == CK_TB_DRAW)
+		return CK_TB_DRAWN;
+	*plies = value - 1;
+	return (*plies & 1) ? CK_TB_WIN : CK_TB_LOSS;
+}
@@ -0,0 +1,86 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersTablebase.h
+//# Win/loss/draw endgame tables for English checkers, with the
+//# distance to the end of the game, read straight out of a
+//# memory-mapped file (or any other block of memory).
+//#
+//# File layout, little endian:
+//#   16 byte header: "PCTB", version, max pieces, slice count (2 bytes), 8 reserved
+//#   slice count * 16 byte directory entries:
+//#     red men, red kings, blue men, blue kings, 4 reserved, data offset (8 bytes)
+//#   one byte per position for each slice, see CK_TB_* below
+//#
+//# A slice is every position with one particular set of piece
+//# counts.  Its positions are numbered by ranking where each
+//# group of pieces stands, see CK_TablebaseIndex.
+//###############################################################
+#pragma once
+#include "CheckersEngine.h"
+
+#include <stddef.h>
+
+#define CK_TB_VERSION 1
+#define CK_TB_MAXPIECES 6
+
+// Position bytes.  0 is a draw, otherwise the game ends value - 1 plies from now,
+// with the side to move winning if that's odd and losing if it's even.
+#define CK_TB_DRAW 0
+
+// Probe results.
+#define CK_TB_UNKNOWN -1
+#define CK_TB_LOSS 0
+#define CK_TB_WIN 1
+#define CK_TB_DRAWN 2
+
+typedef struct
+{
+	const unsigned char *data;
+	size_t size;
+	int maxPieces;
+	int sliceCount;
+	short slices[CK_TB_MAXPIECES + 1][CK_TB_MAXPIECES + 1][CK_TB_MAXPIECES + 1][CK_TB_MAXPIECES + 1]; // directory entry by piece counts, -1 if none
+
+	const void *mapping; // set when CK_OpenTablebase mapped the file
+} CheckersTablebase;
+
+// Maps a tablebase file read-only.  Returns 0 on success, -1 if it can't be opened or
+// isn't a tablebase, or if this platform can't map files.
+int CK_OpenTablebase(CheckersTablebase *tb, const char *path);
+void CK_CloseTablebase(CheckersTablebase *tb);
+
+// Uses a tablebase that's already in memory, e.g. linked into flash.  Same return values.
+int CK_AttachTablebase(CheckersTablebase *tb, const void *data, size_t size);
+
+// Number of positions in the slice with these piece counts, both sides to move.
+unsigned long CK_TablebaseSliceSize(int redMen, int redKings, int blueMen, int blueKings);
+
+// Where pos sits in its slice.
+unsigned long CK_TablebaseIndex(const CheckersPosition *pos);
+
+// Turns an index back into a position with the given piece counts.  Returns 0 if the
+// index doesn't stand for a real position because two pieces would share a square.
+int CK_TablebasePosition(unsigned long index, int redMen, int redKings, int blueMen, int blueKings, CheckersPosition *pos);
+
+// The stored byte for pos, or -1 if the tablebase doesn't cover it.
+int CK_TablebaseValue(const CheckersTablebase *tb, const CheckersPosition *pos);
+
+// Result for the side to move, one of CK_TB_*, and the plies until the game ends if it's won or lost.
+int CK_ProbeTablebase(const CheckersTablebase *tb, const CheckersPosition *pos, int *plies);
@@ -21,6 +21,8 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 //###############################################################
 #pragma once
 #include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+#include "GameContext.h"
 
 // Ensures that all game functions are unique and won't generate linker errors if we switch strategies.
 // Assign a gamecode by changing the text before the ## symbols.  Use format [Three Letters]_
@@ -47,32 +49,104 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 #define MSLOT_G_RESTART 0
 #define MSLOT_G_RECONFIGURE 1
 
-// Gameplay Variables
-static unsigned char m_bIsSetup; // 1 if setup phase, 0 if game phase.
-static unsigned char m_iBoardSize;
-static short timerEnable = 0;
+// Gameplay Variables.  One set per table, see GameContext.h.
+typedef struct
+{
+	unsigned char bIsSetup; // 1 if setup phase, 0 if game phase.
+	unsigned char iBoardSize;
+	short timerEnable;
+
+	int turnCount;
+
+	// Everything we draw goes through here and reaches the LEDs once per callback.
+	LEDFrameBuffer frameBuffer;
+
+	// The board is kept here and the LEDs only ever show it, never get read back.
+	unsigned char board[LIGHTSBOARDSIZE][LIGHTSBOARDSIZE]; // piece color on each square, OFFCOLOR if empty
+	unsigned char marks[LIGHTSBOARDSIZE][LIGHTSBOARDSIZE]; // MOVECOLOR/JUMPCOLOR highlights, 0 if none
 
-static int turnCount = 0;
+	// Pieces each side has brought home, counted up by MovePiece.
+	int P1Points, P2Points;
+
+	// MakeMove's selection, carried between presses.
+	int jumpString;
+	int previous[2];
+	short movesDisplayed;
+} ChineseCheckersContext;
+
+DECLARE_GAME_CONTEXT(ChineseCheckersContext)
 
 // Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
+static short CheckCorners(int x, int y, int color, short eT);
+
+#define OFFBOARD -1
+
+static int PieceAt(ChineseCheckersContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return OFFBOARD;
+
+	return ctx->board[x][y];
+}
+
+static int MarkAt(ChineseCheckersContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return 0;
+
+	return ctx->marks[x][y];
+}
+
+//Pushes a square to its LED.  Highlights go over everything, and empty corner squares show the corner color.
+static void DrawSquare(ChineseCheckersContext *ctx, int x, int y)
+{
+	int color = ctx->board[x][y];
+
+	if (ctx->marks[x][y])
+		color = ctx->marks[x][y];
+	else if (color == OFFCOLOR && CheckCorners(x, y, P2COLOR, 1))
+		color = P1CORNERCOLOR;
+	else if (color == OFFCOLOR && CheckCorners(x, y, P1COLOR, 1))
+		color = P2CORNERCOLOR;
+
+	FB_IlluminateButton(&ctx->frameBuffer, x, y, color);
+}
+
+static void SetPiece(ChineseCheckersContext *ctx, int x, int y, int color)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return;
+
+	ctx->board[x][y] = (unsigned char)color;
+	DrawSquare(ctx, x, y);
+}
+
+static void SetMark(ChineseCheckersContext *ctx, int x, int y, int color)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDSIZE || y >= LIGHTSBOARDSIZE)
+		return;
+
+	ctx->marks[x][y] = (unsigned char)color;
+	DrawSquare(ctx, x, y);
+}
 
-static unsigned short InitSetupPhase(unsigned short freshConfiguration)
+static unsigned short InitSetupPhase(ChineseCheckersContext *ctx, unsigned short freshConfiguration)
 {
-	m_bIsSetup = 1;
+	ctx->bIsSetup = 1;
 
 	if (freshConfiguration) // Do initial setup stuff here that should only happen on fresh reloads.
 	{
 		// Create our "home" configuration.
-		SetBoardSize(LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
-		IlluminateBoard(OFFCOLOR);
+		FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
+		FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
-		timerEnable = 0;
+		ctx->timerEnable = 0;
 
 		SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP);
 	}
 	else // Do any cleanup here to freeze the gamestate of a previous playthrough.
 	{
-		if (timerEnable == 1) {
+		if (ctx->timerEnable == 1) {
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 1);
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER2, 1);
 		}
@@ -88,15 +162,15 @@ static unsigned short InitSetupPhase(unsigned short freshConfiguration)
 	else
 		RegisterMenuOption(SPT_OPTIONS_RESTARTGAME, IMAGEID_NONE, MSLOT_S_STARTGAME);
 
-	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
 
 	// Nothing that can cause errors here, really, so always return 0.
 	return 0;
 }
 
-static void InitGamePhase()
+static void InitGamePhase(ChineseCheckersContext *ctx)
 {
-	m_bIsSetup = 0;
+	ctx->bIsSetup = 0;
 
 	// Play our start que
 	PlaySoundPreset(SOUNDID_GAMESTART);
@@ -109,50 +183,33 @@ static void InitGamePhase()
 	SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSTART);
 
 	// Create our starting LED configuration.
-	SetBoardSize(LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
-	IlluminateBoard(OFFCOLOR);
-
-	//P1Board
-	IlluminateButton(3, 7, P1COLOR);
-	IlluminateButton(4, 7, P1COLOR);
-	IlluminateButton(5, 7, P1COLOR);
-	IlluminateButton(6, 7, P1COLOR);
-	IlluminateButton(7, 7, P1COLOR);
-	IlluminateButton(4, 6, P1COLOR);
-	IlluminateButton(5, 6, P1COLOR);
-	IlluminateButton(6, 6, P1COLOR);
-	IlluminateButton(7, 6, P1COLOR);
-	IlluminateButton(5, 5, P1COLOR);
-	IlluminateButton(6, 5, P1COLOR);
-	IlluminateButton(7, 5, P1COLOR);
-	IlluminateButton(6, 4, P1COLOR);
-	IlluminateButton(7, 4, P1COLOR);
-	IlluminateButton(7, 3, P1COLOR);
-
-	//P2Board
-	IlluminateButton(0, 0, P2COLOR);
-	IlluminateButton(1, 0, P2COLOR);
-	IlluminateButton(2, 0, P2COLOR);
-	IlluminateButton(3, 0, P2COLOR);
-	IlluminateButton(4, 0, P2COLOR);
-	IlluminateButton(0, 1, P2COLOR);
-	IlluminateButton(1, 1, P2COLOR);
-	IlluminateButton(2, 1, P2COLOR);
-	IlluminateButton(3, 1, P2COLOR);
-	IlluminateButton(0, 2, P2COLOR);
-	IlluminateButton(1, 2, P2COLOR);
-	IlluminateButton(2, 2, P2COLOR);
-	IlluminateButton(0, 3, P2COLOR);
-	IlluminateButton(1, 3, P2COLOR);
-	IlluminateButton(0, 4, P2COLOR);
-
-	if (timerEnable) {
+	FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDSIZE, LIGHTSBOARDSIZE);
+	FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
+
+	//each player starts with their own corner full
+	for (int i = 0; i < LIGHTSBOARDSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDSIZE; j++) {
+			ctx->board[i][j] = OFFCOLOR;
+			ctx->marks[i][j] = 0;
+
+			if (CheckCorners(i, j, P2COLOR, 1))
+				SetPiece(ctx, i, j, P1COLOR);
+			else if (CheckCorners(i, j, P1COLOR, 1))
+				SetPiece(ctx, i, j, P2COLOR);
+		}
+	}
+
+	if (ctx->timerEnable) {
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER1, 1200); // Timer starts at 1200 seconds
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER2, 1200); // Timer starts at 1200 seconds
 		SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 3);
 	}
 
-	turnCount = 0;
+	ctx->turnCount = 0;
+	ctx->P1Points = 0;
+	ctx->P2Points = 0;
+	ctx->jumpString = 0;
+	ctx->movesDisplayed = 0;
 
 	// Init our game phase menu.
 	ClearAllMenuOptions();
@@ -231,10 +288,10 @@ static short CheckCorners(int x, int y, int color, short eT) {
 
 //Displays the moves for a given (x, y)
 //When jumped is set to 1, it will only display jumps (in the jump color). It signifies a multiple jump scenerio.
-static short DisplayMoves(int x, int y, int prevX, int prevY, short jumped)
+static short DisplayMoves(ChineseCheckersContext *ctx, int x, int y, int prevX, int prevY, short jumped)
 {
-	int color = GetButtonColorAtPos(x, y), displayColor = MOVECOLOR;
-	int playerTurn = turnCount % 2;
+	int color = PieceAt(ctx, x, y), displayColor = MOVECOLOR;
+	int playerTurn = ctx->turnCount % 2;
 	short flag = 0, eT = 0;
 	char timerVal, enemyTimer;
 
@@ -255,27 +312,27 @@ static short DisplayMoves(int x, int y, int prevX, int prevY, short jumped)
 	for (int i = -1; i <= 1; i++) {
 		for (int j = -1; j <= 1; j++) {
 
-			if ((GetButtonColorAtPos(x + i, y + j) != P1COLOR && GetButtonColorAtPos(x + i, y + j) != P2COLOR) && jumped != 1) {
+			if (PieceAt(ctx, x + i, y + j) == OFFCOLOR && jumped != 1) {
 				//if we are in enemey territory, only display moves within that territory
 				if (eT == 1) {
 					if (CheckCorners(x + i, y + j, color, 1))
-						IlluminateButton(x + i, y + j, displayColor);
+						SetMark(ctx, x + i, y + j, displayColor);
 				}
-				else IlluminateButton(x + i, y + j, displayColor);
+				else SetMark(ctx, x + i, y + j, displayColor);
 			}
 
-			else if ((GetButtonColorAtPos(x + i, y + j) == P1COLOR || GetButtonColorAtPos(x + i, y + j) == P2COLOR) && (GetButtonColorAtPos(x + (i * 2), y + (j * 2)) != P1COLOR && GetButtonColorAtPos(x + (i * 2), y + (j * 2)) != P2COLOR)) {
+			else if ((PieceAt(ctx, x + i, y + j) == P1COLOR || PieceAt(ctx, x + i, y + j) == P2COLOR) && PieceAt(ctx, x + (i * 2), y + (j * 2)) == OFFCOLOR) {
 				//if we are in enemey territory, only display moves within that territory
 				if (x + (i * 2) == prevX && y + (j * 2) == prevY)
 					continue;
 				if (eT == 1) {
 					if (CheckCorners(x + (i * 2), y + (j * 2), color, 1)) {
-						IlluminateButton(x + (i * 2), y + (j * 2), displayColor);
+						SetMark(ctx, x + (i * 2), y + (j * 2), displayColor);
 						flag = 1;
 					}
 				}
 				else {
-					IlluminateButton(x + (i * 2), y + (j * 2), displayColor);
+					SetMark(ctx, x + (i * 2), y + (j * 2), displayColor);
 					flag = 1;
 				}
 			}
@@ -284,8 +341,8 @@ static short DisplayMoves(int x, int y, int prevX, int prevY, short jumped)
 
 	/*if (flag == 0 && jumped == 1){
 
-	turnCount++;
-	if (timerEnable) {
+	ctx->turnCount++;
+	if (ctx->timerEnable) {
 	SetLCDTimerCountMode(timerVal, 1);
 	SetLCDTimerCountMode(enemyTimer, 3);
 	}
@@ -298,67 +355,43 @@ static short DisplayMoves(int x, int y, int prevX, int prevY, short jumped)
 }
 
 //Erases all displayed moves of a given (x, y)
-static void EraseMoves(int x, int y, int color) {
+static void EraseMoves(ChineseCheckersContext *ctx, int x, int y) {
 
-	int cornerColor;
-	switch (color) {
-	case P1COLOR: cornerColor = P1CORNERCOLOR; break;
-	case P2COLOR: cornerColor = P2CORNERCOLOR; break;
-	}
-
-
-	//similar loop to DisplayMoves but does the opposite
-	for (int i = -1; i <= 1; i++) {
-		for (int j = -1; j <= 1; j++) {
-			if (GetButtonColorAtPos(x + i, y + j) == MOVECOLOR || GetButtonColorAtPos(x + i, y + j) == JUMPCOLOR) {
-				if (CheckCorners(x + i, y + j, color, 0)) {
-					IlluminateButton(x + i, y + j, cornerColor);
-				}
-				else IlluminateButton(x + i, y + j, OFFCOLOR);
-			}
-			else if (GetButtonColorAtPos(x + (i * 2), y + (j * 2)) == MOVECOLOR || GetButtonColorAtPos(x + (i * 2), y + (j * 2)) == JUMPCOLOR) {
-				if (CheckCorners(x + (i * 2), y + (j * 2), color, 0)) {
-					IlluminateButton(x + (i * 2), y + (j * 2), cornerColor);
-				}
-				else IlluminateButton(x + (i * 2), y + (j * 2), OFFCOLOR);
-			}
+	for (int i = -2; i <= 2; i++) {
+		for (int j = -2; j <= 2; j++) {
+			if (MarkAt(ctx, x + i, y + j))
+				SetMark(ctx, x + i, y + j, 0);
 		}
 	}
 }
 
 //Moves a piece from (prevX, prevY) to (x, y)
-static short MovePiece(int x, int y, int prevX, int prevY, int color) {
-
-	static int P1Points = 0, P2Points = 0;
-	int cornerColor;
+static short MovePiece(ChineseCheckersContext *ctx, int x, int y, int prevX, int prevY, int color) {
 
 	char victory;
 
 	switch (color) {
-	case P1COLOR: cornerColor = P1CORNERCOLOR; victory = SPT_GAMEMESSAGE_REDVICTORY; break;
-	case P2COLOR: cornerColor = P2CORNERCOLOR; victory = SPT_GAMEMESSAGE_BLUEVICTORY; break;
+	case P1COLOR: victory = SPT_GAMEMESSAGE_REDVICTORY; break;
+	case P2COLOR: victory = SPT_GAMEMESSAGE_BLUEVICTORY; break;
 	}
 
 	//erase the displayed moves, move piece to new location, and erase the piece from the old location
-	EraseMoves(prevX, prevY, color);
-	IlluminateButton(x, y, color);
-	if (CheckCorners(prevX, prevY, color, 0))
-		IlluminateButton(prevX, prevY, cornerColor);
-	else
-		IlluminateButton(prevX, prevY, OFFCOLOR);
+	EraseMoves(ctx, prevX, prevY);
+	SetPiece(ctx, x, y, color);
+	SetPiece(ctx, prevX, prevY, OFFCOLOR);
 
 	//if we moved a piece into the enemy corner, add a point. 
 	if (CheckCorners(x, y, color, 1) == 1 && CheckCorners(prevX, prevY, color, 1) != 1) {
 		if (color == P1COLOR)
-			P1Points++;
+			ctx->P1Points++;
 		else
-			P2Points++;
+			ctx->P2Points++;
 	}
 
 	//if we have 15 points, that means all pieces are in the enemy corner. we win!
-	if (P1Points >= 15 || P2Points >= 15) {
+	if (ctx->P1Points >= 15 || ctx->P2Points >= 15) {
 		SetLCDGameMessage(victory);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 	}
 
 	//if the move was a jump, return 1, else return 0
@@ -367,12 +400,9 @@ static short MovePiece(int x, int y, int prevX, int prevY, int color) {
 	else return 0;
 }
 
-static void MakeMove(int x, int y) {
+static void MakeMove(ChineseCheckersContext *ctx, int x, int y) {
 
-	static int jumpString = 0;
-	static int previous[2];
-	static short movesDisplayed = 0;
-	int playerTurn = turnCount % 2;
+	int playerTurn = ctx->turnCount % 2;
 	int color;
 
 	char timerVal, enemyTimer;
@@ -384,30 +414,30 @@ static void MakeMove(int x, int y) {
 	}
 
 	//selecting a piece to move
-	if (GetButtonColorAtPos(x, y) == color && jumpString != 1) {
+	if (PieceAt(ctx, x, y) == color && ctx->jumpString != 1) {
 
 		//displays moves
-		if (movesDisplayed == 0) {
-			DisplayMoves(x, y, previous[0], previous[1], 0);
-			movesDisplayed = 1;
+		if (ctx->movesDisplayed == 0) {
+			DisplayMoves(ctx, x, y, ctx->previous[0], ctx->previous[1], 0);
+			ctx->movesDisplayed = 1;
 		}
 		//other moves already displayed, delete those and display moves for the newly selected piece
 		else {
-			EraseMoves(previous[0], previous[1], color);
-			DisplayMoves(x, y, previous[0], previous[1], 0);
+			EraseMoves(ctx, ctx->previous[0], ctx->previous[1]);
+			DisplayMoves(ctx, x, y, ctx->previous[0], ctx->previous[1], 0);
 		}
-		previous[0] = x;
-		previous[1] = y;
+		ctx->previous[0] = x;
+		ctx->previous[1] = y;
 		return;
 	}
 
 	//conditional for ending a multiple jump scenario preemptively
-	if (x == previous[0] && y == previous[1] && jumpString == 1) {
+	if (x == ctx->previous[0] && y == ctx->previous[1] && ctx->jumpString == 1) {
 
-		EraseMoves(x, y, color);
-		jumpString = 0;
-		turnCount++;
-		if (timerEnable) {
+		EraseMoves(ctx, x, y);
+		ctx->jumpString = 0;
+		ctx->turnCount++;
+		if (ctx->timerEnable) {
 			SetLCDTimerCountMode(timerVal, 1);
 			SetLCDTimerCountMode(enemyTimer, 3);
 		}
@@ -415,45 +445,45 @@ static void MakeMove(int x, int y) {
 	}
 
 	//selecting where you want your piece to move
-	if (GetButtonColorAtPos(x, y) == MOVECOLOR) {
+	if (MarkAt(ctx, x, y) == MOVECOLOR) {
 
 		//moves piece, if it was a jump, initiate a multiple jump scenario
-		if (MovePiece(x, y, previous[0], previous[1], color) == 1) {
-			if (DisplayMoves(x, y, previous[0], previous[1], 1)) {
-				jumpString = 1;
-				previous[0] = x;
-				previous[1] = y;
+		if (MovePiece(ctx, x, y, ctx->previous[0], ctx->previous[1], color) == 1) {
+			if (DisplayMoves(ctx, x, y, ctx->previous[0], ctx->previous[1], 1)) {
+				ctx->jumpString = 1;
+				ctx->previous[0] = x;
+				ctx->previous[1] = y;
 				return;
 			}
 		}
 
 		//not a jump, carry on
-		turnCount++;
-		if (timerEnable) {
+		ctx->turnCount++;
+		if (ctx->timerEnable) {
 			SetLCDTimerCountMode(timerVal, 1);
 			SetLCDTimerCountMode(enemyTimer, 3);
 		}
-		movesDisplayed = 0;
+		ctx->movesDisplayed = 0;
 		return;
 	}
 
 
 	//continuing through multiple jump scenario
-	if (GetButtonColorAtPos(x, y) == JUMPCOLOR) {
+	if (MarkAt(ctx, x, y) == JUMPCOLOR) {
 
-		MovePiece(x, y, previous[0], previous[1], color);
+		MovePiece(ctx, x, y, ctx->previous[0], ctx->previous[1], color);
 
 		//jump string continues
-		if (DisplayMoves(x, y, previous[0], previous[1], 1)) {
-			previous[0] = x;
-			previous[1] = y;
+		if (DisplayMoves(ctx, x, y, ctx->previous[0], ctx->previous[1], 1)) {
+			ctx->previous[0] = x;
+			ctx->previous[1] = y;
 			return;
 		}
 		//jump string has ended, carry on
 		else {
-			jumpString = 0;
-			turnCount++;
-			if (timerEnable) {
+			ctx->jumpString = 0;
+			ctx->turnCount++;
+			if (ctx->timerEnable) {
 				SetLCDTimerCountMode(timerVal, 1);
 				SetLCDTimerCountMode(enemyTimer, 3);
 			}
@@ -467,16 +497,24 @@ static void MakeMove(int x, int y) {
 
 GF_PREFIX int GAMEFUNC(OnGameLoaded)()
 {
-	return InitSetupPhase(1);
+	ChineseCheckersContext *ctx = GetContext();
+	unsigned short result = InitSetupPhase(ctx, 1);
+
+	FB_Commit(&ctx->frameBuffer);
+	return result;
 }
 
 
 GF_PREFIX void GAMEFUNC(OnButtonPressed)(int x, int y)
 {
-	if (m_bIsSetup)
+	ChineseCheckersContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 		PlaySoundPreset(SOUNDID_DENY);
 	else
-		MakeMove(x, y);
+		MakeMove(ctx, x, y);
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnLCDButtonPressed)(int id)
@@ -497,29 +535,35 @@ GF_PREFIX void GAMEFUNC(OnTimerFinished)(int id)
 
 GF_PREFIX void GAMEFUNC(OnLCDTimerHitZero)(int id)
 {
+	ChineseCheckersContext *ctx = GetContext();
+
 	switch (id) {
 	case TM_LCD_TIMER_PLAYER1:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	case TM_LCD_TIMER_PLAYER2:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 {
-	if (m_bIsSetup)
+	ChineseCheckersContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 	{
 		switch (id)
 		{
-		case MSLOT_S_STARTGAME: InitGamePhase(); break;
+		case MSLOT_S_STARTGAME: InitGamePhase(ctx); break;
 		case MSLOT_S_TT:
-			timerEnable = timerEnable ? 0 : 1;
+			ctx->timerEnable = ctx->timerEnable ? 0 : 1;
 
-			RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+			RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
 			break;
 		}
 	}
@@ -527,10 +571,12 @@ GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 	{
 		switch (id)
 		{
-		case MSLOT_G_RESTART: InitGamePhase(); break;
-		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(0); break;
+		case MSLOT_G_RESTART: InitGamePhase(ctx); break;
+		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(ctx, 0); break;
 		}
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 // Fires when the system has not received an input for a "long time"
@@ -0,0 +1,106 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# DraughtsEngine.c
+//# Builds one move generator per variant from DraughtsMoves.inc.
+//###############################################################
+#include "DraughtsEngine.h"
+
+#include <string.h>
+
+#define DV_PASTE2(NAME, FUNCNAME) DV_##NAME##_##FUNCNAME
+#define DV_PASTE(NAME, FUNCNAME) DV_PASTE2(NAME, FUNCNAME)
+
+#define DV_NAME English
+#define DV_SIZE 8
+#define DV_FLYINGKINGS 0
+#define DV_MENCAPTUREBACK 0
+#define DV_MAXCAPTURE 0
+#define DV_PROMOTEMIDCAPTURE 1
+#define DV_REMOVEATONCE 1
+#include "DraughtsMoves.inc"
+
+#define DV_NAME Russian
+#define DV_SIZE 8
+#define DV_FLYINGKINGS 1
+#define DV_MENCAPTUREBACK 1
+#define DV_MAXCAPTURE 0
+#define DV_PROMOTEMIDCAPTURE 1
+#define DV_REMOVEATONCE 0
+#include "DraughtsMoves.inc"
+
+#define DV_NAME Brazilian
+#define DV_SIZE 8
+#define DV_FLYINGKINGS 1
+#define DV_MENCAPTUREBACK 1
+#define DV_MAXCAPTURE 1
+#define DV_PROMOTEMIDCAPTURE 0
+#define DV_REMOVEATONCE 0
+#include "DraughtsMoves.inc"
+
+#define DV_NAME International
+#define DV_SIZE 10
+#define DV_FLYINGKINGS 1
+#define DV_MENCAPTUREBACK 1
+#define DV_MAXCAPTURE 1
+#define DV_PROMOTEMIDCAPTURE 0
+#define DV_REMOVEATONCE 0
+#include "DraughtsMoves.inc"
+
+#define DV_VARIANT(NAME, LABEL, SIZE) \
+	{ LABEL, SIZE, DV_##NAME##_SetStartPosition, DV_##NAME##_GenerateMoves, DV_##NAME##_MakeMove, DV_##NAME##_Perft }
+
+const DraughtsVariant DV_Variants[DV_VARIANTCOUNT] =
+{
+	DV_VARIANT(English, "english", 8),
+	DV_VARIANT(Russian, "russian", 8),
+	DV_VARIANT(Brazilian, "brazilian", 8),
+	DV_VARIANT(International, "international", 10),
+};
+
+const DraughtsVariant *DV_FindVariant(const char *name)
+{
+	for (int i = 0; i < DV_VARIANTCOUNT; i++) {
+		if (strcmp(DV_Variants[i].name, name) == 0)
+			return &DV_Variants[i];
+	}
+	return 0;
+}
+
+// Each pair of rows takes size + 1 bits, the last of them unused.
+int DV_Square(int size, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= size || y >= size || (x + y) % 2 == 0)
+		return -1;
+	return y * (size / 2) + x / 2 + y / 2;
+}
+
+int DV_SquareX(int size, int s)
+{
+	int half = size / 2, rem = s % (size + 1);
+
+	return rem < half ? rem * 2 + 1 : (rem - half) * 2;
+}
+
+int DV_SquareY(int size, int s)
+{
+	int half = size / 2, rem = s % (size + 1);
+
+	return s / (size + 1) * 2 + (rem < half ? 0 : 1);
+}
@@ -0,0 +1,120 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# DraughtsEngine.h
+//# Draughts rules for the variants the bigger tables can play:
+//# English, Russian and Brazilian on 8x8 and International on
+//# 10x10.  Every variant gets its own move generator, built from
+//# DraughtsMoves.inc with the rules fixed at compile time, so
+//# none of them tests a rule flag while it generates.
+//#
+//# Checkers.c keeps using CheckersEngine, which is the English
+//# generator on 32-bit boards and stays the fastest way to play
+//# 8x8 English.
+//###############################################################
+#pragma once
+
+// Dark squares are bits, five to a row on 10x10 and four on 8x8, with one
+// unused bit after every second row so each diagonal step is the same shift
+// everywhere on the board: size / 2 along one diagonal and size / 2 + 1 along
+// the other.  See DV_Square for the mapping to (x, y).
+//
+// As in CheckersEngine, side 0 moves first, starts at the highest rows and
+// moves towards row 0, and row 0's dark squares are at odd x.
+#define DV_SIDES 2
+#define DV_MAXSIZE 10
+#define DV_MAXHOPS 20   // every enemy piece on 10x10
+#define DV_MAXMOVES 512 // a board full of flying kings can have a few hundred
+
+typedef struct
+{
+	unsigned long long pieces[DV_SIDES];
+	unsigned long long kings;
+	int side;
+} DraughtsPosition;
+
+typedef struct
+{
+	unsigned char from, to;
+	unsigned char hops;                 // pieces captured, 0 for a plain step
+	unsigned char path[DV_MAXHOPS + 1]; // from, each landing square, to
+	unsigned long long captured;
+} DraughtsMove;
+
+typedef struct
+{
+	int count;
+	DraughtsMove moves[DV_MAXMOVES];
+} DraughtsMoveList;
+
+// Index of the lowest set bit.  bb must not be 0.
+static inline int DV_Lowest(unsigned long long bb)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(bb);
+#else
+	int s = 0;
+
+	while (!(bb & 1)) {
+		bb >>= 1;
+		s++;
+	}
+	return s;
+#endif
+}
+
+// One variant's generator.  Every function here is specialised for its rules.
+typedef struct
+{
+	const char *name;
+	int size;
+	void (*setStartPosition)(DraughtsPosition *pos);
+	int (*generateMoves)(const DraughtsPosition *pos, DraughtsMoveList *list);
+	void (*makeMove)(DraughtsPosition *pos, const DraughtsMove *move);
+	unsigned long long (*perft)(const DraughtsPosition *pos, int depth); // leaf nodes, counting the last ply from the move list
+} DraughtsVariant;
+
+#define DV_DECLARE_VARIANT(NAME) \
+	void DV_##NAME##_SetStartPosition(DraughtsPosition *pos); \
+	int DV_##NAME##_GenerateMoves(const DraughtsPosition *pos, DraughtsMoveList *list); \
+	void DV_##NAME##_MakeMove(DraughtsPosition *pos, const DraughtsMove *move); \
+	unsigned long long DV_##NAME##_Perft(const DraughtsPosition *pos, int depth);
+
+// English: the rules CheckersEngine plays.  Men capture forwards only, kings move one
+// square, any capture may be chosen, and a man crowned mid-jump carries on as a king.
+DV_DECLARE_VARIANT(English)
+// Russian: men capture backwards too, kings fly, any capture may be chosen, and a man
+// crowned mid-capture carries on as a king.
+DV_DECLARE_VARIANT(Russian)
+// Brazilian: International rules on 8x8.
+DV_DECLARE_VARIANT(Brazilian)
+// International: 10x10, men capture backwards too, kings fly, the capture that takes the
+// most pieces must be played, and a man is only crowned if his move ends on the far row.
+DV_DECLARE_VARIANT(International)
+
+#define DV_VARIANTCOUNT 4
+extern const DraughtsVariant DV_Variants[DV_VARIANTCOUNT];
+
+// 0 if there's no variant by that name.
+const DraughtsVariant *DV_FindVariant(const char *name);
+
+// Board coordinates for a board of the given size.  DV_Square returns -1 for light squares and anything off the board.
+int DV_Square(int size, int x, int y);
+int DV_SquareX(int size, int s);
+int DV_SquareY(int size, int s);
@@ -0,0 +1,57 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GameContext.h
+//# Where a game finds its state when a callback comes in.
+//###############################################################
+#pragma once
+
+// Every game keeps all of its state in one context struct and passes it down
+// to its own functions.  The callbacks can't take it as a parameter since the
+// firmware fixes their signatures, so they fetch it with GetContext().
+//
+// On the table there's only ever one game of each kind, so the context is a
+// plain static.  The host simulator instead hands out the context belonging to
+// whichever table the calling thread has bound, so any number of tables can be
+// running the same game at once.
+//
+// Use once per game, after the struct:  DECLARE_GAME_CONTEXT(CheckersContext)
+//
+// Scratch is for big arrays a game only needs while one callback is working
+// something out, like a search tree, which would be wasted kept in every
+// table's context.  GetScratch() returns COUNT of TYPE, not cleared, and
+// they're only the caller's until the callback returns.  On the table that's
+// a plain static again; the host keeps one for each thread running tables.
+//
+// Use at most once per game:  DECLARE_GAME_SCRATCH(GoNode, AI_NODES)
+#ifdef HOST_SIMULATOR
+#include "HostSimulator.h"
+
+#define DECLARE_GAME_CONTEXT(TYPE) \
+	static TYPE *GetContext() { return (TYPE *)Sim_GetGameContext(sizeof(TYPE)); }
+#define DECLARE_GAME_SCRATCH(TYPE, COUNT) \
+	static TYPE *GetScratch() { return (TYPE *)Sim_GetScratch(sizeof(TYPE) * (unsigned long)(COUNT)); }
+#else
+#define DECLARE_GAME_CONTEXT(TYPE) \
+	static TYPE m_context; \
+	static TYPE *GetContext() { return &m_context; }
+#define DECLARE_GAME_SCRATCH(TYPE, COUNT) \
+	static TYPE m_scratch[COUNT]; \
+	static TYPE *GetScratch() { return m_scratch; }
+#endif
@@ -21,6 +21,14 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 //###############################################################
 #pragma once
 #include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+#include "GameContext.h"
+#include "GoBoard.h"
+#include "GoBenson.h"
+#include "GoBitboard.h"
+#include "GoMCTS.h"
+#include "GoOwnership.h"
+#include "GoTactics.h"
 
 #ifdef DEBUGCHECKS
 #include "DebugFunctions.h"
@@ -40,54 +48,122 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 #define OFFCOLOR GC_GRAY
 #define ONCOLOR GC_WHITE
 #define CAPTURED GC_YELLOW
+#define HINTCOLOR GC_GREEN
+#define P1LEAN GC_PINK   // empty points that look more red's than blue's
+#define P2LEAN GC_PURPLE // and the other way round
 
 #define P1SCORE TM_LCD_SCORE_PLAYER1
 #define P2SCORE TM_LCD_SCORE_PLAYER2
 
-#define BOARDSIZE 9
+// Points along each side: 9, 13 or 19, set by GoBoard.h.  The bigger boards
+// need a tiled table or the simulator, so build with -DGO_BOARDSIZE=13 or 19
+// for those, and GoBoard sizes its arrays to match.
+#define BOARDSIZE GO_BOARDSIZE
+
+#if BOARDSIZE > GO_MAXSIZE || BOARDSIZE > FB_MAXSIZE
+#error GO_BOARDSIZE is bigger than the board arrays
+#endif
+
+// Computer player.  Games get no clock from the firmware, so its thinking time
+// is turned into a playout budget at the rate the table's CPU plays them.
+#define AI_MOVESECONDS 2
+#define AI_PLAYOUTSPERSECOND 2000
+#define AI_PLAYOUTS (AI_MOVESECONDS * AI_PLAYOUTSPERSECOND)
+#define AI_NODES GO_SEARCHNODES(BOARDSIZE, AI_PLAYOUTS)
+#define AI_KOMI 0 // in half points; the game has never given white any
+#define AI_READNODES 1000 // for each string the hint reads ladders on
+
+// Working out the dead stones once both players pass: a second's playouts on
+// the table, all of them every time so the score never depends on the clock.
+// Points owned by this much of GO_OWNERSHIPSCALE are shaded as territory, and
+// from LEANOWNERSHIP up as leaning that way.
+#define AI_OWNERSHIPPLAYOUTS AI_PLAYOUTSPERSECOND
+#define OWNEDOWNERSHIP 60
+#define LEANOWNERSHIP 20
 
 // Menu IDs
 // Setup
 #define MSLOT_S_STARTGAME 0
 #define MSLOT_S_TT 1
+#define MSLOT_S_COMPUTER 2
 
 // Game
 #define MSLOT_G_RESTART 0
 #define MSLOT_G_RECONFIGURE 1
 
-// Gameplay Variables
-static unsigned char m_bIsSetup; // 1 if setup phase, 0 if game phase.
-static unsigned char m_iBoardSize;
-static short timerEnable = 0;
+// Gameplay Variables.  One set per table, see GameContext.h.
+typedef struct
+{
+	unsigned char bIsSetup; // 1 if setup phase, 0 if game phase.
+	unsigned char iBoardSize;
+	short timerEnable;
+	unsigned char bComputerPlayer; // 1 if the computer plays player 2
+	unsigned char bReviewing; // 1 from the second pass until the players accept the dead stones
+
+	short passes;
+	int P1Score;
+	int P2Score;
+	int turnCount;
+
+	// Everything we draw goes through here and reaches the LEDs once per callback.
+	LEDFrameBuffer frameBuffer;
+
+	// The board is kept here and the LEDs only ever show it, never get read back.
+	unsigned char board[BOARDSIZE][BOARDSIZE]; // stone color on each point, OFFCOLOR if empty
+	GoBoard position;                          // the same stones as strings, for the rules
+	GoHistory history;                         // every position so far, for superko
+	GoBenson benson;                           // points nothing can change the owner of
+	int hint;                                  // point lit up by the last hint, GO_PASS if none
+	unsigned char dead[BOARDSIZE][BOARDSIZE];  // stones marked dead while reviewing
+
+	unsigned int aiRandom; // seeds each search; not reset between games, so they play out differently
+} GoContext;
+
+DECLARE_GAME_CONTEXT(GoContext)
+DECLARE_GAME_SCRATCH(GoNode, AI_NODES) // the search tree, only needed while the computer thinks
+
+// Threads the computer player searches with, shared by every table.  Only one
+// gives the same move every time, which keeps replays exact.  The dead stone
+// playouts use them too, and come out the same however many there are.
+static int m_searchThreads = 1;
 
-static int visited[9][9];
-static int lastPlay[2];
-static short passes = 0;
-static int P1Score = 0;
-static int P2Score = 0;
-static int turnCount = 0;
+// Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
+#define OFFBOARD -1
 
-static void checkSurrounding(int x, int y, int enemy);
-static short checkString(int x, int y, int prevx, int prevy, int enemy, int exitCond, short noCapture, short specialCheck);
+static int StoneAt(GoContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= BOARDSIZE || y >= BOARDSIZE)
+		return OFFBOARD;
 
-// Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
-static unsigned short InitSetupPhase(unsigned short freshConfiguration)
+	return ctx->board[x][y];
+}
+
+//Places (or clears, with OFFCOLOR) a stone and shows it on the board.
+static void SetStone(GoContext *ctx, int x, int y, int color)
 {
-	m_bIsSetup = 1;
+	ctx->board[x][y] = (unsigned char)color;
+	FB_IlluminateButton(&ctx->frameBuffer, x, y, color);
+}
+
+static unsigned short InitSetupPhase(GoContext *ctx, unsigned short freshConfiguration)
+{
+	ctx->bIsSetup = 1;
+	ctx->bReviewing = 0;
 
 	if (freshConfiguration) // Do initial setup stuff here that should only happen on fresh reloads.
 	{
 		// Create our "home" configuration.
-		SetBoardSize(BOARDSIZE, BOARDSIZE);
-		IlluminateBoard(OFFCOLOR);
+		FB_SetBoardSize(&ctx->frameBuffer, BOARDSIZE, BOARDSIZE);
+		FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
 		SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP);
 
-		timerEnable = 0;
+		ctx->timerEnable = 0;
+		ctx->bComputerPlayer = 0;
 	}
 	else // Do any cleanup here to freeze the gamestate of a previous playthrough.
 	{
-		if (timerEnable == 1) {
+		if (ctx->timerEnable == 1) {
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 1);
 			SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER2, 1);
 		}
@@ -102,15 +178,17 @@ static unsigned short InitSetupPhase(unsigned short freshConfiguration)
 	else
 		RegisterMenuOption(SPT_OPTIONS_RESTARTGAME, IMAGEID_NONE, MSLOT_S_STARTGAME);
 
-	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+	RegisterMenuOptionWithStringParameter(SPT_OPTIONS_COMPUTERPLAYER, IMAGEID_NONE, ctx->bComputerPlayer ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_COMPUTER);
 
 	// Nothing that can cause errors here, really, so always return 0.
 	return 0;
 }
 
-static void InitGamePhase()
+static void InitGamePhase(GoContext *ctx)
 {
-	m_bIsSetup = 0;
+	ctx->bIsSetup = 0;
+	ctx->bReviewing = 0;
 
 	// Play our start que
 	PlaySoundPreset(SOUNDID_GAMESTART);
@@ -123,24 +201,27 @@ static void InitGamePhase()
 	SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSTART);
 
 	// Create our starting LED configuration.
-	SetBoardSize(BOARDSIZE, BOARDSIZE);
-	IlluminateBoard(OFFCOLOR);
+	FB_SetBoardSize(&ctx->frameBuffer, BOARDSIZE, BOARDSIZE);
+	FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
-	if (timerEnable) {
+	if (ctx->timerEnable) {
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER1, 3600); // Timer starts at 3600 seconds
 		SetLCDTimerValue(TM_LCD_TIMER_PLAYER2, 3600); // Timer starts at 3600 seconds
 		SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 3);
 	}
 
-	//initializing the visited array for traversal
-	for (int i = 0; i < 9; i++) {
-		for (int j = 0; j < 9; j++)
-			visited[i][j] = 0;
+	for (int i = 0; i < BOARDSIZE; i++) {
+		for (int j = 0; j < BOARDSIZE; j++)
+			ctx->board[i][j] = OFFCOLOR;
 	}
-	passes = 0;
-	P1Score = 0;
-	P2Score = 0;
-	turnCount = 0;
+	GO_Clear(&ctx->position, BOARDSIZE);
+	GO_ResetHistory(&ctx->history, &ctx->position);
+	GO_ResetBenson(&ctx->benson, &ctx->position);
+	ctx->hint = GO_PASS;
+	ctx->passes = 0;
+	ctx->P1Score = 0;
+	ctx->P2Score = 0;
+	ctx->turnCount = 0;
 
 	// Init our game phase menu.
 	ClearAllMenuOptions();
@@ -148,366 +229,396 @@ static void InitGamePhase()
 	RegisterMenuOption(SPT_OPTIONS_RECONFIGURE, IMAGEID_NONE, MSLOT_G_RECONFIGURE);
 }
 
-static void endGame() {
+// Scores the board as it stands by area: stones plus the empty points only
+// one player's stones reach, which are tinted that player's colour.
+static void endGame(GoContext *ctx) {
 
-	//P1 Territory
-	for (int i = 0; i < 9; i++) {
-		for (int j = 0; j < 9; j++) {
-			if (GetButtonColorAtPos(i, j) == P1COLOR)
-				checkSurrounding(i, j, P2COLOR);
-		}
-	}
+	unsigned char owner[GO_POINTS];
+	int score[3];
 
-	//initializing the visited array for traversal
-	for (int i = 0; i < 9; i++) {
-		for (int j = 0; j < 9; j++)
-			visited[i][j] = 0;
-	}
+	// The board is only ever scored once, so the bits are made as they're needed.
+#if BOARDSIZE == GO_BITSSIZE
+	GO_BitsScore(GO_BitsOf(&ctx->position, GO_BLACK), GO_BitsOf(&ctx->position, GO_WHITE), owner, score);
+#else
+	GO_Score(&ctx->position, owner, score);
+#endif
 
-	//P2 Territory
-	for (int i = 0; i < 9; i++) {
-		for (int j = 0; j < 9; j++) {
-			if (GetButtonColorAtPos(i, j) == P2COLOR)
-				checkSurrounding(i, j, P1COLOR);
+	for (int i = 0; i < BOARDSIZE; i++) {
+		for (int j = 0; j < BOARDSIZE; j++) {
+			int p = GO_Point(i, j);
+
+			if (ctx->position.color[p] != GO_EMPTY)
+				continue;
+			if (owner[p] == GO_BLACK)
+				SetStone(ctx, i, j, P1TER);
+			else if (owner[p] == GO_WHITE)
+				SetStone(ctx, i, j, P2TER);
 		}
 	}
 
-	if (P1Score > P2Score) {
+	ctx->P1Score = score[GO_BLACK];
+	ctx->P2Score = score[GO_WHITE];
+	SetLCDScoreDisplayValue(P1SCORE, ctx->P1Score);
+	SetLCDScoreDisplayValue(P2SCORE, ctx->P2Score);
+
+	if (ctx->P1Score > ctx->P2Score) {
 		SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY);
 	}
-	else if (P2Score > P1Score) {
+	else if (ctx->P2Score > ctx->P1Score) {
 		SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY);
 	}
 	else {
 		SetLCDGameMessage(SPT_GAMEMESSAGE_TIEGAME);
 	}
-	InitSetupPhase(0);
+	InitSetupPhase(ctx, 0);
 }
 
-static void checkSurrounding(int x, int y, int enemy) {
-
-	if (GetButtonColorAtPos(x - 1, y) == OFFCOLOR)
-		checkString(x - 1, y, 0, 0, OFFCOLOR, enemy, 0, 0);
-	if (GetButtonColorAtPos(x, y + 1) == OFFCOLOR)
-		checkString(x, y + 1, 0, 0, OFFCOLOR, enemy, 0, 0);
-	if (GetButtonColorAtPos(x + 1, y) == OFFCOLOR)
-		checkString(x + 1, y, 0, 0, OFFCOLOR, enemy, 0, 0);
-	if (GetButtonColorAtPos(x, y - 1) == OFFCOLOR)
-		checkString(x, y - 1, 0, 0, OFFCOLOR, enemy, 0, 0);
+//Puts back whatever the last hint lit up.
+static void ClearHint(GoContext *ctx)
+{
+	if (ctx->hint != GO_PASS) {
+		int x = GO_PointX(ctx->hint), y = GO_PointY(ctx->hint);
 
-	return;
+		FB_IlluminateButton(&ctx->frameBuffer, x, y, ctx->board[x][y]);
+		ctx->hint = GO_PASS;
+	}
 }
 
-static short koRule(int x, int y, int enemy) {
-	
-	int color;
+static void ReviewGame(GoContext *ctx);
 
-	switch (enemy) {
-	case P1COLOR: color = P2COLOR;
-	case P2COLOR: color = P1COLOR;
-	}
+static void MakeMove(GoContext *ctx, int x, int y, short pass) {
 
-	if (checkString(x, y, 0, 0, color, OFFCOLOR, 1, 0))
-		return 1;
-	else return 0;
+	int playerTurn = ctx->turnCount % 2;
+	int color = P1COLOR;
+	char timerVal = TM_LCD_TIMER_PLAYER1;
+	char enemyTimer = TM_LCD_TIMER_PLAYER2;
+	unsigned char recip = P1SCORE;
+	int *score = &ctx->P1Score;
+	short captured[GO_MAXSTONES];
+	int p, count, bGameOver;
 
-}
+	ClearHint(ctx);
 
-static short checkString(int x, int y, int prevx, int prevy, int enemy, int exitCond, short noCapture, short specialCheck) {
+	if (pass == 1) {
+		GO_Play(&ctx->position, GO_PASS, 0);
+		ctx->turnCount++;
+		return;
+	}
 
-	unsigned char recip;
-	int score, terColor, color;
+	switch (playerTurn) {
+	case 0: color = P1COLOR; timerVal = TM_LCD_TIMER_PLAYER1;  enemyTimer = TM_LCD_TIMER_PLAYER2; recip = P1SCORE; score = &ctx->P1Score; break;
+	case 1: color = P2COLOR; timerVal = TM_LCD_TIMER_PLAYER2;  enemyTimer = TM_LCD_TIMER_PLAYER1; recip = P2SCORE; score = &ctx->P2Score; break;
+	}
 
-	if (exitCond == OFFCOLOR) {
-		switch (enemy) {
-		case P2COLOR: recip = P1SCORE; color = P1COLOR;  score = P1Score;  terColor = (GC_RED + GC_DARK);  break;
-		case P1COLOR: recip = P2SCORE; color = P2COLOR;  score = P2Score;  terColor = P2TER;  break;
-		}
+	// Occupied points, suicide and bringing back any earlier position are all refused.
+	p = GO_Point(x, y);
+	if (StoneAt(ctx, x, y) == OFFBOARD || !GO_IsLegal(&ctx->position, p) || GO_Seen(&ctx->history, GO_HashAfter(&ctx->position, p))) {
+		PlaySoundPreset(SOUNDID_DENY);
+		return;
 	}
-	else {
-		switch (exitCond) {
-		case P2COLOR: recip = P1SCORE; color = P1COLOR; score = P1Score;  terColor = (GC_RED + GC_DARK); break;
-		case P1COLOR: recip = P2SCORE; color = P2COLOR; score = P2Score;  terColor = P2TER; break;
-		}
+
+	count = GO_Play(&ctx->position, p, captured);
+	bGameOver = !GO_RecordPosition(&ctx->history, &ctx->position);
+	GO_UpdateBenson(&ctx->benson, &ctx->position);
+	SetStone(ctx, x, y, color);
+	for (int i = 0; i < count; i++)
+		SetStone(ctx, GO_PointX(captured[i]), GO_PointY(captured[i]), OFFCOLOR);
+
+	// Each stone taken is a point to whoever took it.
+	if (count) {
+		*score += count;
+		SetLCDScoreDisplayValue(recip, *score);
 	}
 
-	short tempVisited[9][9];
-	for (int i = 0; i < 9; i++) {
-		for (int j = 0; j < 9; j++) {
-			tempVisited[i][j] = 0;
-		}
+	ctx->turnCount++;
+	ctx->passes = 0;
+	if (ctx->timerEnable) {
+		SetLCDTimerCountMode(timerVal, 1);
+		SetLCDTimerCountMode(enemyTimer, 3);
 	}
 
-	if (exitCond == OFFCOLOR) {
-		for (int i = 0; i < 9; i++) {
-			for (int j = 0; j < 9; j++) {
-				visited[i][j] = 0;
-			}
-		}
+	// A game that has run to GO_MAXPOSITIONS is counted as it stands.
+	if (bGameOver)
+		ReviewGame(ctx);
+}
+
+//Both players have passed, or the game has run its length.  Plays the
+//position out to find the dead stones, lights them up and shades every empty
+//point by who it looks to belong to.  The players can then press a string to
+//change its mind about it, and pass once more to take the dead stones off and
+//count.  Settled points need no guessing, and if the whole board is settled
+//there are no playouts at all.
+static void ReviewGame(GoContext *ctx)
+{
+	GoOwnershipLimits limits;
+	short ownership[GO_POINTS];
+	int unsettled = 0;
+
+	for (int p = 0; p < GO_POINTS; p++) {
+		ownership[p] = 0;
+		if (ctx->position.color[p] != GO_BORDER && ctx->benson.owner[p] == GO_EMPTY)
+			unsettled++;
 	}
 
-	if (noCapture)
-		IlluminateButton(x, y, enemy);
-	if (specialCheck)
-		IlluminateButton(prevx, prevy, color);
-
-	if (visited[x][y] == 1)
-		return 0;
-
-	int queue[81][2];
-	int rear = -1;
-	int front = 0;
-	int queueItemCount = 0;
-
-	//visited[x][y] = 1;
-	tempVisited[x][y] = 1;
-	rear++;
-	queue[rear][0] = x;
-	queue[rear][1] = y;
-	queueItemCount++;
-
-	while (queueItemCount != 0) {
-
-		int tempPiece[2];
-		tempPiece[0] = queue[front][0];
-		tempPiece[1] = queue[front][1];
-		front++;
-		queueItemCount--;
-
-		if (y > 0) {
-			if (GetButtonColorAtPos(tempPiece[0], tempPiece[1] - 1) == exitCond) {
-				if (noCapture)
-					IlluminateButton(x, y, OFFCOLOR);
-				else if (specialCheck)
-					IlluminateButton(prevx, prevy, OFFCOLOR);
-				return 0;
-			}
-			else if (GetButtonColorAtPos(tempPiece[0], tempPiece[1] - 1) == enemy && (/*visited[tempPiece[0]][tempPiece[1] - 1] == 0 || */tempVisited[tempPiece[0]][tempPiece[1] - 1] == 0)) {
-				//visited[tempPiece[0]][tempPiece[1] - 1] = 1;
-				tempVisited[tempPiece[0]][tempPiece[1] - 1] = 1;
-				rear++;
-				queue[rear][0] = tempPiece[0];
-				queue[rear][1] = tempPiece[1] - 1;
-				queueItemCount++;
-			}
-		}
-		if (x < 8) {
-			if (GetButtonColorAtPos(tempPiece[0] + 1, tempPiece[1]) == exitCond) {
-				if (noCapture)
-					IlluminateButton(x, y, OFFCOLOR);
-				else if (specialCheck)
-					IlluminateButton(prevx, prevy, OFFCOLOR);
-				return 0;
-			}
-			else if (GetButtonColorAtPos(tempPiece[0] + 1, tempPiece[1]) == enemy && (/*visited[tempPiece[0] + 1][tempPiece[1]] == 0 || */tempVisited[tempPiece[0] + 1][tempPiece[1]] == 0)) {
-				//visited[tempPiece[0] + 1][tempPiece[1]] = 1;
-				tempVisited[tempPiece[0] + 1][tempPiece[1]] = 1;
-				rear++;
-				queue[rear][0] = tempPiece[0] + 1;
-				queue[rear][1] = tempPiece[1];
-				queueItemCount++;
-			}
-		}
-		if (y < 8) {
-			if (GetButtonColorAtPos(tempPiece[0], tempPiece[1] + 1) == exitCond) {
-				if (noCapture)
-					IlluminateButton(x, y, OFFCOLOR);
-				else if (specialCheck)
-					IlluminateButton(prevx, prevy, OFFCOLOR);
-				return 0;
-			}
-			else if (GetButtonColorAtPos(tempPiece[0], tempPiece[1] + 1) == enemy && (/*visited[tempPiece[0]][tempPiece[1] + 1] == 0 || */tempVisited[tempPiece[0]][tempPiece[1] + 1] == 0)) {
-				//visited[tempPiece[0]][tempPiece[1] + 1] = 1;
-				tempVisited[tempPiece[0]][tempPiece[1] + 1] = 1;
-				rear++;
-				queue[rear][0] = tempPiece[0];
-				queue[rear][1] = tempPiece[1] + 1;
-				queueItemCount++;
-			}
-		}
-		if (x > 0) {
-			if (GetButtonColorAtPos(tempPiece[0] - 1, tempPiece[1]) == exitCond) {
-				if (noCapture)
-					IlluminateButton(x, y, OFFCOLOR);
-				else if (specialCheck)
-					IlluminateButton(prevx, prevy, OFFCOLOR);
-				return 0;
-			}
-			else if (GetButtonColorAtPos(tempPiece[0] - 1, tempPiece[1]) == enemy && (/*visited[tempPiece[0] - 1][tempPiece[1]] == 0 || */tempVisited[tempPiece[0] - 1][tempPiece[1]] == 0)) {
-				//visited[tempPiece[0] - 1][tempPiece[1]] = 1;
-				tempVisited[tempPiece[0] - 1][tempPiece[1]] = 1;
-				rear++;
-				queue[rear][0] = tempPiece[0] - 1;
-				queue[rear][1] = tempPiece[1];
-				queueItemCount++;
-			}
-		}
+	if (unsettled) {
+		ctx->aiRandom = ctx->aiRandom * 1103515245u + 12345u;
+
+		limits.playouts = AI_OWNERSHIPPLAYOUTS;
+		limits.maxMillis = 0;
+		limits.threads = m_searchThreads;
+		limits.seed = ctx->aiRandom >> 8;
+		GO_EstimateOwnership(&ctx->position, &limits, ownership);
 	}
 
-	if (noCapture != 1) {
-
-		if (exitCond == OFFCOLOR) {
-			//if we made it this far, the whole string is captured
-			for (int i = 0; i < 9; i++) {
-				for (int j = 0; j < 9; j++) {
-					if (tempVisited[i][j] == 1) {
-						if (i == lastPlay[0] && j == lastPlay[1]) {
-							if (koRule(prevx, prevy, enemy)) {
-								IlluminateButton(prevx, prevy, OFFCOLOR);
-								PlaySoundPreset(SOUNDID_DENY);
-								return 0;
-							}
-						}
-						SetLCDScoreDisplayValue(recip, ++score);
-						IlluminateButton(i, j, OFFCOLOR);
-					}
-				}
-			}
+	for (int p = 0; p < GO_POINTS; p++) {
+		if (ctx->benson.owner[p] == GO_BLACK)
+			ownership[p] = GO_OWNERSHIPSCALE;
+		else if (ctx->benson.owner[p] == GO_WHITE)
+			ownership[p] = -GO_OWNERSHIPSCALE;
+	}
 
-			for (int i = 0; i < 9; i++) {
-				for (int j = 0; j < 9; j++)
-					visited[i][j] = 0;
-			}
+	ctx->bReviewing = 1;
+	if (ctx->timerEnable) {
+		SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER1, 1);
+		SetLCDTimerCountMode(TM_LCD_TIMER_PLAYER2, 1);
+	}
 
-			switch (enemy) {
-			case P2COLOR: P1Score = score;  break;
-			case P1COLOR: P2Score = score;  break;
-			}
+	for (int i = 0; i < BOARDSIZE; i++) {
+		for (int j = 0; j < BOARDSIZE; j++) {
+			int p = GO_Point(i, j), color = OFFCOLOR;
 
-		}
-		else {
-			for (int i = 0; i < 9; i++) {
-				for (int j = 0; j < 9; j++) {
-					if (tempVisited[i][j] == 1) {
-						visited[i][j] = 1;
-						IlluminateButton(i, j, terColor);
-						SetLCDScoreDisplayValue(recip, ++score);
-					}
-				}
-			}
+			ctx->dead[i][j] = ctx->position.color[p] != GO_EMPTY && GO_IsDead(&ctx->position, ownership, p);
+			if (ctx->position.color[p] != GO_EMPTY)
+				color = ctx->dead[i][j] ? CAPTURED : ctx->board[i][j];
+			else if (ownership[p] >= OWNEDOWNERSHIP)
+				color = P1TER;
+			else if (ownership[p] <= -OWNEDOWNERSHIP)
+				color = P2TER;
+			else if (ownership[p] >= LEANOWNERSHIP)
+				color = P1LEAN;
+			else if (ownership[p] <= -LEANOWNERSHIP)
+				color = P2LEAN;
 
-			switch (exitCond) {
-			case P2COLOR: P1Score = score; break;
-			case P1COLOR: P2Score = score; break;
-			}
+			// Only lit, so board still holds what's really there.
+			FB_IlluminateButton(&ctx->frameBuffer, i, j, color);
 		}
 	}
-	else
-		IlluminateButton(x, y, OFFCOLOR);
+}
 
-	return 1;
+//Marks the string on (x, y) dead if it wasn't, and alive if it was.  Not
+//for settled stones, which are alive or dead whatever anyone says.
+static void ToggleDead(GoContext *ctx, int x, int y)
+{
+	int p = GO_Point(x, y), s = p;
+	unsigned char dead;
+
+	if (StoneAt(ctx, x, y) == OFFBOARD || ctx->position.color[p] == GO_EMPTY || ctx->benson.owner[p] != GO_EMPTY) {
+		PlaySoundPreset(SOUNDID_DENY);
+		return;
+	}
+
+	dead = !ctx->dead[x][y];
+	do {
+		int sx = GO_PointX(s), sy = GO_PointY(s);
+
+		ctx->dead[sx][sy] = dead;
+		FB_IlluminateButton(&ctx->frameBuffer, sx, sy, dead ? CAPTURED : ctx->board[sx][sy]);
+		s = ctx->position.next[s];
+	} while (s != p);
 }
 
-static short selfCapture(int x, int y, int color, int enemy) {
+//Takes the strings marked dead off the board and counts.
+static void AcceptReview(GoContext *ctx)
+{
+	short removed[GO_MAXSTONES];
 
-	short flag = 0;
+	for (int i = 0; i < BOARDSIZE; i++) {
+		for (int j = 0; j < BOARDSIZE; j++) {
+			int p = GO_Point(i, j), color = ctx->position.color[p], count;
 
-	if (y > 0) {
-		if (GetButtonColorAtPos(x, y - 1) == OFFCOLOR)
-			flag = 1;
-		else if (GetButtonColorAtPos(x, y - 1) == enemy)
-			checkString(x, y-1, x, y, enemy, OFFCOLOR, 0, 1);
-	}
-	if (x < 8) {
-		if (GetButtonColorAtPos(x + 1, y) == OFFCOLOR)
-			flag = 1;
-		else if (GetButtonColorAtPos(x+1, y) == enemy)
-			checkString(x+1, y, x, y, enemy, OFFCOLOR, 0, 1);
-	}
-	if (y < 8) {
-		if (GetButtonColorAtPos(x, y + 1) == OFFCOLOR)
-			flag = 1;
-		else if (GetButtonColorAtPos(x, y + 1) == enemy)
-			checkString(x, y+1, x, y, enemy, OFFCOLOR, 0, 1);
-	}
-	if (x > 0) {
-		if (GetButtonColorAtPos(x - 1, y) == OFFCOLOR)
-			flag = 1;
-		else if (GetButtonColorAtPos(x-1, y) == enemy)
-			checkString(x-1, y, x, y, enemy, OFFCOLOR, 0, 1);
+			if (color == GO_EMPTY || !ctx->dead[i][j])
+				continue;
+
+			count = GO_RemoveString(&ctx->position, p, removed);
+			for (int k = 0; k < count; k++) {
+				int x = GO_PointX(removed[k]), y = GO_PointY(removed[k]);
+
+				ctx->dead[x][y] = 0;
+				SetStone(ctx, x, y, OFFCOLOR);
+			}
+		}
 	}
 
-	if (flag != 1) {
-		if (checkString(x, y, 0, 0, color, OFFCOLOR, 1, 0) == 1)
-			return 1;
-		else return 0;
+	// Clear the shading away before the territory goes on.
+	for (int i = 0; i < BOARDSIZE; i++) {
+		for (int j = 0; j < BOARDSIZE; j++)
+			FB_IlluminateButton(&ctx->frameBuffer, i, j, ctx->board[i][j]);
 	}
-	else return 0;
+	endGame(ctx);
 }
 
-static void MakeMove(int x, int y, short pass) {
-
-	
-	int playerTurn = turnCount % 2;
-	int color = P1COLOR;
-	int enemy = P2COLOR;
-	char timerVal = TM_LCD_TIMER_PLAYER1;
-	char enemyTimer = TM_LCD_TIMER_PLAYER2;
-
-	if (pass == 1) {
-		turnCount++;
+//Two passes in a row end the game, once the dead stones are settled.
+static void Pass(GoContext *ctx)
+{
+	if (ctx->bReviewing) {
+		AcceptReview(ctx);
 		return;
 	}
 
-	switch (playerTurn) {
-	case 0: color = P1COLOR; enemy = P2COLOR; timerVal = TM_LCD_TIMER_PLAYER1;  enemyTimer = TM_LCD_TIMER_PLAYER2;  break;
-	case 1: color = P2COLOR; enemy = P1COLOR; timerVal = TM_LCD_TIMER_PLAYER2;  enemyTimer = TM_LCD_TIMER_PLAYER1; break;
-	}
+	ctx->passes++;
+	MakeMove(ctx, 0, 0, 1);
+	if (ctx->passes >= 2)
+		ReviewGame(ctx);
+}
 
-	if (GetButtonColorAtPos(x, y) == OFFCOLOR) {
-		if (selfCapture(x, y, color, enemy) == 1) {
-			PlaySoundPreset(SOUNDID_DENY);
-			return;
+//Searches the in-memory board for the side to move.  Returns a point or GO_PASS.
+static int ChooseMove(GoContext *ctx)
+{
+	GoSearchLimits limits;
+	GoSearchResult result;
+
+	ctx->aiRandom = ctx->aiRandom * 1103515245u + 12345u;
+
+	limits.nodes = GetScratch();
+	limits.nodeCount = AI_NODES;
+	limits.maxPlayouts = AI_PLAYOUTS;
+	limits.maxMillis = 0;
+	limits.threads = m_searchThreads;
+	limits.komi = AI_KOMI;
+	limits.passes = ctx->passes;
+	limits.history = &ctx->history;
+	limits.settled = ctx->benson.owner;
+	limits.seed = ctx->aiRandom >> 8;
+
+	GO_Search(&ctx->position, &limits, &result);
+	return result.move;
+}
+
+//Plays player 2's reply just as a press or a pass would.
+static void ComputerMove(GoContext *ctx)
+{
+	int move = ChooseMove(ctx);
+
+	if (move == GO_PASS)
+		Pass(ctx);
+	else
+		MakeMove(ctx, GO_PointX(move), GO_PointY(move), 0);
+}
+
+//Reads ladders for whoever's turn it is: theirs that the other side could
+//take by playing first, and the other side's they can take now.  Returns
+//the move that saves or takes the most stones, or GO_PASS if there's none.
+static int TacticalMove(GoContext *ctx)
+{
+	GoBoard *board = &ctx->position;
+	GoReadResult result;
+	GoUndo undo; // lets the reads play ahead on position and back
+	int best = GO_PASS, bestStones = 0;
+
+	GO_ResetUndo(&undo);
+	for (int p = 0; p < GO_POINTS; p++) {
+		if (board->color[p] == GO_EMPTY || board->color[p] == GO_BORDER)
+			continue;
+		if (board->head[p] != p || board->stones[p] <= bestStones)
+			continue;
+
+		if (board->color[p] == board->toMove) {
+			GO_MakeMove(board, &undo, GO_PASS);
+			GO_ReadString(board, &undo, p, GO_LADDERLIBS, AI_READNODES, &result);
+			GO_UnmakeMove(board, &undo);
+			if (result.result != GO_READ_CAPTURED)
+				continue;
+			GO_ReadString(board, &undo, p, GO_LADDERLIBS, AI_READNODES, &result);
+			if (result.result != GO_READ_ESCAPES)
+				continue;
 		}
 		else {
-			IlluminateButton(x, y, color);
-			lastPlay[0] = x;
-			lastPlay[1] = y;
+			GO_ReadString(board, &undo, p, GO_LADDERLIBS, AI_READNODES, &result);
+			if (result.result != GO_READ_CAPTURED)
+				continue;
 		}
+
+		if (result.move == GO_PASS || GO_Seen(&ctx->history, GO_HashAfter(board, result.move)))
+			continue;
+		best = result.move;
+		bestStones = board->stones[p];
 	}
-	else {
+	return best;
+}
+
+//Lights the point to play for whoever's turn it is: a ladder to save or win
+//stones with if there is one, else the computer's choice.  If it would rather
+//pass there's nothing to light, so it just buzzes.
+static void ShowHint(GoContext *ctx)
+{
+	int move = TacticalMove(ctx);
+
+	if (move == GO_PASS)
+		move = ChooseMove(ctx);
+
+	ClearHint(ctx);
+	if (move == GO_PASS) {
 		PlaySoundPreset(SOUNDID_DENY);
 		return;
 	}
 
-	turnCount++;
-	passes = 0;
-	if (timerEnable) {
-		SetLCDTimerCountMode(timerVal, 1);
-		SetLCDTimerCountMode(enemyTimer, 3);
-	}
+	FB_IlluminateButton(&ctx->frameBuffer, GO_PointX(move), GO_PointY(move), HINTCOLOR);
+	ctx->hint = move;
 }
 
 // Standard Callbacks
 
 GF_PREFIX int GAMEFUNC(OnGameLoaded)()
 {
-	return InitSetupPhase(1);
+	GoContext *ctx = GetContext();
+	unsigned short result = InitSetupPhase(ctx, 1);
+
+	FB_Commit(&ctx->frameBuffer);
+	return result;
 }
 
 
 GF_PREFIX void GAMEFUNC(OnButtonPressed)(int x, int y)
 {
-	if (m_bIsSetup)
+	GoContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 		PlaySoundPreset(SOUNDID_DENY);
-	else
-		MakeMove(x, y, 0);
+	else if (ctx->bReviewing)
+		ToggleDead(ctx, x, y);
+	else {
+		MakeMove(ctx, x, y, 0);
+
+		// The computer answers as soon as the turn comes round to it.
+		if (ctx->bComputerPlayer && !ctx->bIsSetup && !ctx->bReviewing && ctx->turnCount % 2 == 1)
+			ComputerMove(ctx);
+	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnLCDButtonPressed)(int id)
 {
+	GoContext *ctx = GetContext();
+
+	if (ctx->bIsSetup) {
+		PlaySoundPreset(SOUNDID_DENY);
+		return;
+	}
+
 	if (id == LCDB_EXTRA1) {
-		if (m_bIsSetup) {
-			PlaySoundPreset(SOUNDID_DENY);
-			return;
-		}
-		passes++;
-		MakeMove(0, 0, 1);
+		Pass(ctx);
+		if (ctx->bComputerPlayer && !ctx->bIsSetup && !ctx->bReviewing && ctx->turnCount % 2 == 1)
+			ComputerMove(ctx);
 	}
-	if (passes >= 2) {
-		endGame();
+	else if (id == LCDB_EXTRA2) {
+		if (ctx->bReviewing)
+			PlaySoundPreset(SOUNDID_DENY);
+		else
+			ShowHint(ctx);
 	}
-	return;
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnExit)(int reason)
@@ -523,29 +634,40 @@ GF_PREFIX void GAMEFUNC(OnTimerFinished)(int id)
 
 GF_PREFIX void GAMEFUNC(OnLCDTimerHitZero)(int id)
 {
+	GoContext *ctx = GetContext();
+
 	switch (id) {
 	case TM_LCD_TIMER_PLAYER1:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	case TM_LCD_TIMER_PLAYER2:
 		SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY);
-		InitSetupPhase(0);
+		InitSetupPhase(ctx, 0);
 		break;
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 {
-	if (m_bIsSetup)
+	GoContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 	{
 		switch (id)
 		{
-			case MSLOT_S_STARTGAME: InitGamePhase(); break;
+			case MSLOT_S_STARTGAME: InitGamePhase(ctx); break;
 			case MSLOT_S_TT:
-				timerEnable = timerEnable ? 0 : 1;
+				ctx->timerEnable = ctx->timerEnable ? 0 : 1;
+
+				RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, ctx->timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+			break;
+			case MSLOT_S_COMPUTER:
+				ctx->bComputerPlayer = ctx->bComputerPlayer ? 0 : 1;
 
-				RegisterMenuOptionWithStringParameter(SPT_OPTIONS_TURNTIMERS, IMAGEID_NONE, timerEnable ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_TT);
+				RegisterMenuOptionWithStringParameter(SPT_OPTIONS_COMPUTERPLAYER, IMAGEID_NONE, ctx->bComputerPlayer ? SPT_UTIL_ON : SPT_UTIL_OFF, MSLOT_S_COMPUTER);
 			break;
 		}
 	}
@@ -553,10 +675,12 @@ GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 	{
 		switch (id)
 		{
-		case MSLOT_G_RESTART: InitGamePhase(); break;
-		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(0); break;
+		case MSLOT_G_RESTART: InitGamePhase(ctx); break;
+		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(ctx, 0); break;
 		}
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 // Fires when the system has not received an input for a "long time"
@@ -583,6 +707,13 @@ GF_PREFIX void GAMEFUNC(OnWake)(int reason)
 // be updated for each game.
 // ----------------------------------------------------------------------------
 
+// Lets the computer player search with more than one thread, on platforms that
+// have them.  Call before any table starts playing.
+void Go_SetSearchThreads(int threads)
+{
+	m_searchThreads = threads;
+}
+
 void Go_RegisterGame(int id)
 {
 	BoardGameInfoList[id].printNamePreset = SPT_GT_GO;
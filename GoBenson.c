@@ -0,0 +1,310 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBenson.c
+//# For each colour, gathers the strings near the changed points
+//# and everything they share vital regions with, runs Benson's
+//# elimination over just those, and writes back their points.
+//###############################################################
+#include "GoBenson.h"
+
+#include <string.h>
+
+static const int m_neighbours[4] = { -GO_STRIDE, 1, GO_STRIDE, -1 };
+
+typedef struct
+{
+	short firstBorder;   // strings around it, in Analysis.borders
+	short borderCount;
+	short firstPoint;    // its points, in Analysis.points
+	short pointCount;
+	short vital[4];      // heads of the strings it's vital to
+	int vitalCount;
+} Region;
+
+// Everything one colour's pass needs.  Strings go by their heads.
+typedef struct
+{
+	const GoBoard *board;
+	int color;
+	short regionOf[GO_POINTS];        // -1 until its region is found
+	short listedBy[GO_POINTS];        // region that last listed each head as a border
+	unsigned char inSet[GO_POINTS];
+	unsigned char alive[GO_POINTS];
+	short eyes[GO_POINTS];
+	short chains[GO_MAXSTONES];
+	int chainCount;
+	Region regions[GO_MAXSTONES];
+	int regionCount;
+	short points[GO_MAXSTONES];
+	int pointCount;
+	short borders[4 * GO_MAXSTONES];
+	int borderCount;
+} Analysis;
+
+static void AddChain(Analysis *a, int h)
+{
+	if (a->inSet[h])
+		return;
+	a->inSet[h] = 1;
+	a->chains[a->chainCount++] = (short)h;
+}
+
+// Floods the region through p and works out who it's vital to.  Returns its
+// index.  Unless whole is set, gives up as soon as it finds the region is
+// vital to nobody, leaving the points it got to marked with a region that
+// lists no borders, so no one else has to flood that region either.
+static int Explore(Analysis *a, int p, int whole)
+{
+	const GoBoard *board = a->board;
+	int r = a->regionCount++, anyEmpty = 0, vitalToNobody = 0;
+	Region *region = &a->regions[r];
+
+	region->firstBorder = (short)a->borderCount;
+	region->firstPoint = (short)a->pointCount;
+	region->vitalCount = 0;
+
+	// The point list doubles as the flood's queue.
+	a->regionOf[p] = (short)r;
+	a->points[a->pointCount++] = (short)p;
+	for (int q = region->firstPoint; q < a->pointCount && !(vitalToNobody && !whole); q++) {
+		int s = a->points[q], around[4], aroundCount = 0;
+
+		for (int i = 0; i < 4; i++) {
+			int n = s + m_neighbours[i], c = board->color[n];
+
+			if (c == GO_BORDER)
+				continue;
+			if (c == a->color) {
+				int h = board->head[n];
+
+				if (a->listedBy[h] != r) {
+					a->listedBy[h] = (short)r;
+					a->borders[a->borderCount++] = (short)h;
+				}
+				around[aroundCount++] = h;
+			}
+			else if (a->regionOf[n] < 0) {
+				a->regionOf[n] = (short)r;
+				a->points[a->pointCount++] = (short)n;
+			}
+			else if (a->regionOf[n] != r)
+				vitalToNobody = 1; // ran into one given up on, which is this region too
+		}
+
+		// Only strings next to every empty point so far can still be vital.
+		if (board->color[s] != GO_EMPTY)
+			continue;
+		if (!anyEmpty) {
+			anyEmpty = 1;
+			for (int i = 0; i < aroundCount; i++) {
+				int j = 0;
+
+				while (j < region->vitalCount && region->vital[j] != around[i])
+					j++;
+				if (j == region->vitalCount)
+					region->vital[region->vitalCount++] = (short)around[i];
+			}
+		}
+		else {
+			int kept = 0;
+
+			for (int j = 0; j < region->vitalCount; j++) {
+				int i = 0;
+
+				while (i < aroundCount && around[i] != region->vital[j])
+					i++;
+				if (i < aroundCount)
+					region->vital[kept++] = region->vital[j];
+			}
+			region->vitalCount = kept;
+		}
+		if (!region->vitalCount)
+			vitalToNobody = 1;
+	}
+
+	if (vitalToNobody && !whole) {
+		region->vitalCount = 0;
+		a->borderCount = region->firstBorder;
+	}
+	region->borderCount = (short)(a->borderCount - region->firstBorder);
+	region->pointCount = (short)(a->pointCount - region->firstPoint);
+	return r;
+}
+
+static int Healthy(const Analysis *a, const Region *region)
+{
+	for (int i = 0; i < region->borderCount; i++) {
+		if (!a->alive[a->borders[region->firstBorder + i]])
+			return 0;
+	}
+	return 1;
+}
+
+static void Analyse(GoBenson *benson, const GoBoard *board, int color, const short *dirty, int dirtyCount, const unsigned char *emptied)
+{
+	Analysis analysis;
+	Analysis *a = &analysis;
+	int changed;
+
+	a->board = board;
+	a->color = color;
+	a->chainCount = a->regionCount = a->pointCount = a->borderCount = 0;
+	for (int p = 0; p < GO_POINTS; p++) {
+		a->regionOf[p] = -1;
+		a->listedBy[p] = -1;
+		a->inSet[p] = a->alive[p] = 0;
+	}
+
+	// Strings on or next to a changed point, and around any region that is
+	// and might have been vital to them before.  Stones going on can't turn
+	// a vital region into one vital to nobody, but stones coming off can, so
+	// regions that gained empty points are flooded whole and done first.
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < dirtyCount; i++) {
+			int p = dirty[i];
+
+			if (emptied[p] != !pass)
+				continue;
+			if (board->color[p] == color)
+				AddChain(a, board->head[p]);
+			else if (a->regionOf[p] < 0) {
+				Region *region = &a->regions[Explore(a, p, emptied[p])];
+
+				for (int j = 0; j < region->borderCount; j++)
+					AddChain(a, a->borders[region->firstBorder + j]);
+			}
+		}
+	}
+
+	// And every string those share a vital region with, and so on.  Regions
+	// vital to nobody can't pass anything on, so they stop the spread.
+	for (int i = 0; i < a->chainCount; i++) {
+		int h = a->chains[i], s = h;
+
+		do {
+			for (int k = 0; k < 4; k++) {
+				int n = s + m_neighbours[k], c = board->color[n];
+
+				if (c == color || c == GO_BORDER)
+					continue;
+				if (a->regionOf[n] < 0) {
+					Region *region = &a->regions[Explore(a, n, 0)];
+
+					for (int j = 0; j < region->borderCount; j++)
+						AddChain(a, a->borders[region->firstBorder + j]);
+				}
+			}
+			s = board->next[s];
+		} while (s != h);
+	}
+
+	// Benson's elimination: drop strings with fewer than two healthy vital
+	// regions until none are left to drop.
+	for (int i = 0; i < a->chainCount; i++)
+		a->alive[a->chains[i]] = 1;
+	do {
+		changed = 0;
+		for (int i = 0; i < a->chainCount; i++)
+			a->eyes[a->chains[i]] = 0;
+		for (int r = 0; r < a->regionCount; r++) {
+			const Region *region = &a->regions[r];
+
+			if (region->vitalCount && Healthy(a, region)) {
+				for (int j = 0; j < region->vitalCount; j++)
+					a->eyes[region->vital[j]]++;
+			}
+		}
+		for (int i = 0; i < a->chainCount; i++) {
+			int h = a->chains[i];
+
+			if (a->alive[h] && a->eyes[h] < 2) {
+				a->alive[h] = 0;
+				changed = 1;
+			}
+		}
+	} while (changed);
+
+	// Only our own marks are cleared, so the other colour's pass keeps its.
+	for (int i = 0; i < a->chainCount; i++) {
+		int h = a->chains[i], s = h;
+
+		do {
+			if (a->alive[h])
+				benson->owner[s] = (unsigned char)color;
+			else if (benson->owner[s] == color)
+				benson->owner[s] = GO_EMPTY;
+			s = board->next[s];
+		} while (s != h);
+	}
+	for (int r = 0; r < a->regionCount; r++) {
+		const Region *region = &a->regions[r];
+		int safe = region->vitalCount && Healthy(a, region);
+
+		for (int i = 0; i < region->pointCount; i++) {
+			int p = a->points[region->firstPoint + i];
+
+			if (safe)
+				benson->owner[p] = (unsigned char)color;
+			else if (benson->owner[p] == color)
+				benson->owner[p] = GO_EMPTY;
+		}
+	}
+}
+
+void GO_ResetBenson(GoBenson *benson, const GoBoard *board)
+{
+	// Nothing matches, so the update looks at every point.
+	memset(benson->color, 0xFF, sizeof(benson->color));
+	memset(benson->owner, GO_EMPTY, sizeof(benson->owner));
+	GO_UpdateBenson(benson, board);
+}
+
+void GO_UpdateBenson(GoBenson *benson, const GoBoard *board)
+{
+	short dirty[GO_POINTS];
+	unsigned char listed[GO_POINTS], emptied[GO_POINTS];
+	int dirtyCount = 0;
+
+	memset(listed, 0, sizeof(listed));
+	memset(emptied, 0, sizeof(emptied));
+	for (int p = 0; p < GO_POINTS; p++) {
+		if (benson->color[p] == board->color[p])
+			continue;
+		benson->color[p] = board->color[p];
+		if (board->color[p] == GO_BORDER)
+			continue;
+
+		benson->owner[p] = GO_EMPTY;
+		emptied[p] = board->color[p] == GO_EMPTY;
+		for (int i = -1; i < 4; i++) {
+			int n = i < 0 ? p : p + m_neighbours[i];
+
+			if (board->color[n] != GO_BORDER && !listed[n]) {
+				listed[n] = 1;
+				dirty[dirtyCount++] = (short)n;
+			}
+		}
+	}
+
+	if (dirtyCount) {
+		Analyse(benson, board, GO_BLACK, dirty, dirtyCount, emptied);
+		Analyse(benson, board, GO_WHITE, dirty, dirtyCount, emptied);
+	}
+}
@@ -0,0 +1,53 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBenson.h
+//# Benson's algorithm: the strings that can never be captured,
+//# however many moves in a row the other side gets, and the
+//# points they make safe.  Kept up to date a move at a time.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+
+// A string is unconditionally alive when it has two vital regions that
+// stay healthy.  A region is a connected set of points without the string's
+// colour on them, and it's vital to the string if all of its empty points
+// are the string's liberties.  It's healthy while every string around it is
+// still alive.
+//
+// Whether a string lives only depends on the strings it shares vital regions
+// with.  So after a move, only those linked that way to the points that
+// changed are looked at again, which is rarely more than a group or two.
+typedef struct
+{
+	unsigned char color[GO_POINTS]; // the board as it was last looked at
+	unsigned char owner[GO_POINTS]; // GO_BLACK or GO_WHITE where settled, else GO_EMPTY
+} GoBenson;
+
+// Settled points are the stones of unconditionally alive strings and every
+// point of the vital regions they keep healthy, enemy stones in them
+// included.  Nothing either side does can change who those points count
+// for, so there's no need to think about them.
+
+// Works the whole of board out from scratch.
+void GO_ResetBenson(GoBenson *benson, const GoBoard *board);
+
+// Brings owner up to date with board, looking only at what changed since the
+// last call.  Costs nothing if nothing did.
+void GO_UpdateBenson(GoBenson *benson, const GoBoard *board);
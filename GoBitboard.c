@@ -0,0 +1,143 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBitboard.c
+//# Strings and regions of a 9x9 board grown a whole ring of
+//# points at a time.
+//###############################################################
+#include "GoBitboard.h"
+
+static int Count64(unsigned long long bb)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(bb);
+#else
+	int count = 0;
+
+	for (; bb; bb &= bb - 1)
+		count++;
+	return count;
+#endif
+}
+
+static int Lowest64(unsigned long long bb)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(bb);
+#else
+	int i = 0;
+
+	while (!(bb & 1)) {
+		bb >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+int GO_BitsCount(GoBits a)
+{
+	unsigned long long lo, hi;
+
+	GO_BitsSplit(a, &lo, &hi);
+	return Count64(lo) + Count64(hi);
+}
+
+GoBits GO_BitsOf(const GoBoard *board, int color)
+{
+	unsigned long long words[2] = { 0, 0 };
+
+	for (int y = 0; y < GO_BITSSIZE; y++) {
+		for (int x = 0; x < GO_BITSSIZE; x++) {
+			int i = y * GO_BITSROW + x;
+
+			if (board->color[GO_Point(x, y)] == color)
+				words[i >> 6] |= 1ull << (i & 63);
+		}
+	}
+	return GO_BitsMake(words[0], words[1]);
+}
+
+GoBits GO_BitsFlood(GoBits seed, GoBits within)
+{
+	GoBits grown;
+
+	for (;;) {
+		grown = GO_BitsAnd(GO_BitsOr(seed, GO_BitsDilate(seed)), within);
+		if (GO_BitsEqual(grown, seed))
+			return seed;
+		seed = grown;
+	}
+}
+
+// Lowest point of a, which must not be empty.
+static GoBits Lowest(GoBits a)
+{
+	unsigned long long lo, hi;
+
+	GO_BitsSplit(a, &lo, &hi);
+	return lo ? GO_BitsMake(lo & (0 - lo), 0) : GO_BitsMake(0, hi & (0 - hi));
+}
+
+GoBits GO_BitsCaptures(GoBits own, GoBits enemy, GoBits move)
+{
+	GoBits empty = GO_BitsAndNot(GO_BitsBoard(), GO_BitsOr(GO_BitsOr(own, enemy), move));
+	GoBits next = GO_BitsAnd(GO_BitsDilate(move), enemy);
+	GoBits captured = GO_BitsMake(0, 0);
+
+	// One neighbouring string at a time, each taken if nothing empty touches it.
+	while (!GO_BitsIsEmpty(next)) {
+		GoBits string = GO_BitsFlood(Lowest(next), enemy);
+
+		if (GO_BitsIsEmpty(GO_BitsLiberties(string, empty)))
+			captured = GO_BitsOr(captured, string);
+		next = GO_BitsAndNot(next, string);
+	}
+	return captured;
+}
+
+void GO_BitsScore(GoBits black, GoBits white, unsigned char owner[GO_POINTS], int score[3])
+{
+	GoBits empty = GO_BitsAndNot(GO_BitsBoard(), GO_BitsOr(black, white));
+
+	// Empty points each colour can reach.  Territory is what only one of them can.
+	GoBits reachBlack = GO_BitsFlood(GO_BitsAnd(GO_BitsDilate(black), empty), empty);
+	GoBits reachWhite = GO_BitsFlood(GO_BitsAnd(GO_BitsDilate(white), empty), empty);
+	GoBits own[3];
+
+	own[GO_BLACK] = GO_BitsOr(black, GO_BitsAndNot(reachBlack, reachWhite));
+	own[GO_WHITE] = GO_BitsOr(white, GO_BitsAndNot(reachWhite, reachBlack));
+
+	for (int p = 0; p < GO_POINTS; p++)
+		owner[p] = GO_EMPTY;
+
+	for (int color = GO_BLACK; color <= GO_WHITE; color++) {
+		unsigned long long words[2];
+
+		score[color] = GO_BitsCount(own[color]);
+		GO_BitsSplit(own[color], &words[0], &words[1]);
+		for (int w = 0; w < 2; w++) {
+			for (unsigned long long bb = words[w]; bb; bb &= bb - 1) {
+				int i = w * 64 + Lowest64(bb);
+
+				owner[GO_Point(i % GO_BITSROW, i / GO_BITSROW)] = (unsigned char)color;
+			}
+		}
+	}
+}
@@ -0,0 +1,140 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBitboard.h
+//# A 9x9 Go board as one 128-bit value, so strings, liberties,
+//# captures and territory come from whole-board shifts instead
+//# of point-by-point floods.  SSE2 where the compiler has it,
+//# a pair of 64-bit words everywhere else.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+
+// Point (x, y) is bit y * 10 + x.  Bit 9 of each row is always clear, so a
+// shift by one can't carry a stone round to the next row.
+#define GO_BITSSIZE 9
+#define GO_BITSROW 10
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+typedef __m128i GoBits;
+
+static inline GoBits GO_BitsMake(unsigned long long lo, unsigned long long hi) { return _mm_set_epi64x((long long)hi, (long long)lo); }
+static inline GoBits GO_BitsOr(GoBits a, GoBits b) { return _mm_or_si128(a, b); }
+static inline GoBits GO_BitsAnd(GoBits a, GoBits b) { return _mm_and_si128(a, b); }
+static inline GoBits GO_BitsAndNot(GoBits a, GoBits b) { return _mm_andnot_si128(b, a); } // a & ~b
+
+static inline int GO_BitsEqual(GoBits a, GoBits b)
+{
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+}
+
+// Shifts of the whole 128 bits.  The halves shift on their own, then the bits
+// that cross the middle are moved over with a byte shift.  n is 1 to 63.
+static inline GoBits GO_BitsUp(GoBits a, int n)
+{
+	return _mm_or_si128(_mm_slli_epi64(a, n), _mm_srli_epi64(_mm_slli_si128(a, 8), 64 - n));
+}
+
+static inline GoBits GO_BitsDown(GoBits a, int n)
+{
+	return _mm_or_si128(_mm_srli_epi64(a, n), _mm_slli_epi64(_mm_srli_si128(a, 8), 64 - n));
+}
+
+static inline void GO_BitsSplit(GoBits a, unsigned long long *lo, unsigned long long *hi)
+{
+	unsigned long long words[2];
+
+	_mm_storeu_si128((__m128i *)words, a);
+	*lo = words[0];
+	*hi = words[1];
+}
+#else
+typedef struct
+{
+	unsigned long long lo, hi;
+} GoBits;
+
+static inline GoBits GO_BitsMake(unsigned long long lo, unsigned long long hi) { GoBits r; r.lo = lo; r.hi = hi; return r; }
+static inline GoBits GO_BitsOr(GoBits a, GoBits b) { return GO_BitsMake(a.lo | b.lo, a.hi | b.hi); }
+static inline GoBits GO_BitsAnd(GoBits a, GoBits b) { return GO_BitsMake(a.lo & b.lo, a.hi & b.hi); }
+static inline GoBits GO_BitsAndNot(GoBits a, GoBits b) { return GO_BitsMake(a.lo & ~b.lo, a.hi & ~b.hi); }
+static inline int GO_BitsEqual(GoBits a, GoBits b) { return a.lo == b.lo && a.hi == b.hi; }
+static inline GoBits GO_BitsUp(GoBits a, int n) { return GO_BitsMake(a.lo << n, (a.hi << n) | (a.lo >> (64 - n))); }
+static inline GoBits GO_BitsDown(GoBits a, int n) { return GO_BitsMake((a.lo >> n) | (a.hi << (64 - n)), a.hi >> n); }
+
+static inline void GO_BitsSplit(GoBits a, unsigned long long *lo, unsigned long long *hi)
+{
+	*lo = a.lo;
+	*hi = a.hi;
+}
+#endif
+
+// Every point of the board.
+static inline GoBits GO_BitsBoard()
+{
+	// Nine rows of nine ones, ten bits apart.  Row 6 straddles the two words.
+	return GO_BitsMake(0xF7FDFF7FDFF7FDFFull, 0x0000000001FF7FDFull);
+}
+
+static inline int GO_BitsIsEmpty(GoBits a)
+{
+	unsigned long long lo, hi;
+
+	GO_BitsSplit(a, &lo, &hi);
+	return (lo | hi) == 0;
+}
+
+// The points next to any point of a, on the board.
+static inline GoBits GO_BitsDilate(GoBits a)
+{
+	GoBits spread = GO_BitsOr(GO_BitsOr(GO_BitsUp(a, 1), GO_BitsDown(a, 1)), GO_BitsOr(GO_BitsUp(a, GO_BITSROW), GO_BitsDown(a, GO_BITSROW)));
+
+	return GO_BitsAnd(spread, GO_BitsBoard());
+}
+
+static inline GoBits GO_BitsPoint(int x, int y)
+{
+	int i = y * GO_BITSROW + x;
+
+	return i < 64 ? GO_BitsMake(1ull << i, 0) : GO_BitsMake(0, 1ull << (i - 64));
+}
+
+int GO_BitsCount(GoBits a);
+
+// The stones of one colour on a 9x9 GoBoard.
+GoBits GO_BitsOf(const GoBoard *board, int color);
+
+// Everything in within joined to seed through within.  Seed must be part of within.
+GoBits GO_BitsFlood(GoBits seed, GoBits within);
+
+// Empty points next to a string.
+static inline GoBits GO_BitsLiberties(GoBits string, GoBits empty)
+{
+	return GO_BitsAnd(GO_BitsDilate(string), empty);
+}
+
+// Enemy stones that playing move, a single point, would capture.
+GoBits GO_BitsCaptures(GoBits own, GoBits enemy, GoBits move);
+
+// GO_Score from the stones of each colour.  Converting a GoBoard with
+// GO_BitsOf costs more than the scoring itself, so callers that score often
+// should keep the bits up to date as they play.
+void GO_BitsScore(GoBits black, GoBits white, unsigned char owner[GO_POINTS], int score[3]);
@@ -0,0 +1,474 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBoard.c
+//# Stone placement and capture for Go.  A move only touches the
+//# strings beside it, so nothing here ever scans the board.
+//###############################################################
+#include "GoBoard.h"
+
+static const int m_neighbours[4] = { -GO_STRIDE, 1, GO_STRIDE, -1 };
+
+// Key of the empty board.  Anything but 0, which marks an empty history slot.
+#define EMPTYKEY 0x6A09E667F3BCC908ull
+
+// Zobrist key for a stone of color on p.  Worked out with a SplitMix64 step
+// rather than looked up, since a table for every point of the biggest board
+// would be bigger than the board itself.
+static unsigned long long StoneKey(int color, int p)
+{
+	unsigned long long z = (unsigned long long)(p * 2 + color) * 0x9E3779B97F4A7C15ull;
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+static void AddLiberty(GoBoard *board, int h, int p)
+{
+	board->libs[h]++;
+	board->libSum[h] += p;
+	board->libSumSq[h] += p * p;
+}
+
+static void RemoveLiberty(GoBoard *board, int h, int p)
+{
+	board->libs[h]--;
+	board->libSum[h] -= p;
+	board->libSumSq[h] -= p * p;
+}
+
+// Joins two strings, relabelling the stones of whichever is smaller.
+// Returns the head kept.
+static int Merge(GoBoard *board, int a, int b)
+{
+	int s, t;
+
+	if (board->stones[a] < board->stones[b]) {
+		t = a;
+		a = b;
+		b = t;
+	}
+
+	s = b;
+	do {
+		board->head[s] = (short)a;
+		s = board->next[s];
+	} while (s != b);
+
+	// Cutting both rings open and crossing the ends makes one ring.
+	t = board->next[a];
+	board->next[a] = board->next[b];
+	board->next[b] = (short)t;
+
+	board->stones[a] += board->stones[b];
+	board->libs[a] += board->libs[b];
+	board->libSum[a] += board->libSum[b];
+	board->libSumSq[a] += board->libSumSq[b];
+	return a;
+}
+
+// Takes the string headed by h off the board, giving its points back as
+// liberties to the strings around it.  Returns the number of stones.
+static int RemoveString(GoBoard *board, int h, short *captured)
+{
+	int color = board->color[h], capturer = GO_OTHER(color);
+	int s = h, count = 0;
+
+	do {
+		board->color[s] = GO_EMPTY;
+		board->hash ^= StoneKey(color, s);
+		if (captured)
+			captured[count] = (short)s;
+		count++;
+
+		for (int i = 0; i < 4; i++) {
+			int n = s + m_neighbours[i];
+
+			if (board->color[n] == capturer)
+				AddLiberty(board, board->head[n], s);
+		}
+		s = board->next[s];
+	} while (s != h);
+
+	return count;
+}
+
+int GO_Clear(GoBoard *board, int size)
+{
+	if (size < 1 || size > GO_MAXSIZE)
+		return 0;
+
+	board->size = size;
+	board->toMove = GO_BLACK;
+	board->ko = GO_PASS;
+	board->captures[GO_BLACK] = board->captures[GO_WHITE] = 0;
+	board->hash = EMPTYKEY;
+
+	for (int p = 0; p < GO_POINTS; p++)
+		board->color[p] = GO_BORDER;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++)
+			board->color[GO_Point(x, y)] = GO_EMPTY;
+	}
+	return 1;
+}
+
+int GO_IsEye(const GoBoard *board, int p, int color)
+{
+	static const int diagonals[4] = { -GO_STRIDE - 1, -GO_STRIDE + 1, GO_STRIDE - 1, GO_STRIDE + 1 };
+	int edge = 0, enemy = 0;
+
+	for (int i = 0; i < 4; i++) {
+		int c = board->color[p + m_neighbours[i]];
+
+		if (c == GO_BORDER)
+			edge = 1;
+		else if (c != color)
+			return 0;
+	}
+
+	for (int i = 0; i < 4; i++)
+		enemy += board->color[p + diagonals[i]] == GO_OTHER(color);
+	return enemy + edge < 2;
+}
+
+int GO_IsLegal(const GoBoard *board, int p)
+{
+	if (p == GO_PASS)
+		return 1;
+	if (board->color[p] != GO_EMPTY || p == board->ko)
+		return 0;
+
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+		int c = board->color[n];
+
+		if (c == GO_EMPTY)
+			return 1;
+		// Joining a string that has another liberty, or taking the last one of an enemy string.
+		if (c != GO_BORDER && (c == board->toMove) != GO_InAtari(board, n))
+			return 1;
+	}
+	return 0;
+}
+
+// GO_Play, filling in record if it isn't 0, which needs captured too.
+static int Play(GoBoard *board, int p, short *captured, GoUndoMove *record)
+{
+	int color = board->toMove, enemy = GO_OTHER(color);
+	int count = 0, h;
+
+	if (record) {
+		record->move = (short)p;
+		record->ko = (short)board->ko;
+		record->hash = board->hash;
+		record->ownCount = record->mergeCount = record->takenCount = 0;
+		record->takenTotal = 0;
+	}
+
+	board->toMove = enemy;
+	board->ko = GO_PASS;
+	if (p == GO_PASS)
+		return 0;
+
+	board->color[p] = (unsigned char)color;
+	board->hash ^= StoneKey(color, p);
+	board->head[p] = board->next[p] = (short)p;
+	board->stones[p] = 1;
+	board->libs[p] = 0;
+	board->libSum[p] = board->libSumSq[p] = 0;
+
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+
+		if (board->color[n] == GO_EMPTY)
+			AddLiberty(board, p, n);
+		else if (board->color[n] != GO_BORDER) {
+			h = board->head[n];
+			if (record && board->color[n] == color) {
+				int j = 0;
+
+				while (j < record->ownCount && record->own[j] != h)
+					j++;
+				if (j == record->ownCount) {
+					record->own[j] = (short)h;
+					record->ownStones[j] = board->stones[h];
+					record->ownLibs[j] = board->libs[h];
+					record->ownLibSum[j] = board->libSum[h];
+					record->ownLibSumSq[j] = board->libSumSq[h];
+					record->ownCount++;
+				}
+			}
+			RemoveLiberty(board, h, p);
+		}
+	}
+
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+
+		if (board->color[n] == color && board->head[n] != board->head[p]) {
+			int a = board->head[p], b = board->head[n], kept = Merge(board, a, b);
+
+			if (record) {
+				record->merges[record->mergeCount][0] = (short)kept;
+				record->merges[record->mergeCount][1] = (short)(kept == a ? b : a);
+				record->mergeCount++;
+			}
+		}
+	}
+
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+
+		if (board->color[n] == enemy && board->libs[board->head[n]] == 0) {
+			int taken = RemoveString(board, board->head[n], captured ? captured + count : 0);
+
+			if (record)
+				record->taken[record->takenCount++] = (short)taken;
+			count += taken;
+		}
+	}
+	board->captures[color] += count;
+	if (record)
+		record->takenTotal = (short)count;
+
+	// A lone stone that took a lone stone and is left with just that point
+	// could be taken straight back, which would repeat the position.
+	h = board->head[p];
+	if (count == 1 && board->stones[h] == 1 && board->libs[h] == 1)
+		board->ko = board->libSum[h];
+
+	return count;
+}
+
+int GO_Play(GoBoard *board, int p, short *captured)
+{
+	return Play(board, p, captured, 0);
+}
+
+void GO_ResetUndo(GoUndo *undo)
+{
+	undo->depth = 0;
+	undo->stoneCount = 0;
+}
+
+int GO_MakeMove(GoBoard *board, GoUndo *undo, int p)
+{
+	int count;
+
+	if (undo->depth == GO_UNDODEPTH || undo->stoneCount + GO_MAXSTONES > GO_UNDOSTONES)
+		return -1;
+
+	count = Play(board, p, undo->stones + undo->stoneCount, &undo->moves[undo->depth]);
+	undo->depth++;
+	undo->stoneCount += count;
+	return count;
+}
+
+void GO_UnmakeMove(GoBoard *board, GoUndo *undo)
+{
+	const GoUndoMove *record = &undo->moves[--undo->depth];
+	int p = record->move, enemy = board->toMove, color = GO_OTHER(enemy);
+	const short *taken;
+
+	board->toMove = color;
+	board->ko = record->ko;
+	board->hash = record->hash;
+	if (p == GO_PASS)
+		return;
+
+	// Put the strings taken back, each ring in the order RemoveString walked
+	// it from its head, and take back the liberties they gave away.  They had
+	// none but p, which they get back when p is emptied below.
+	undo->stoneCount -= record->takenTotal;
+	board->captures[color] -= record->takenTotal;
+	taken = undo->stones + undo->stoneCount;
+	for (int t = 0; t < record->takenCount; t++) {
+		int count = record->taken[t], h = taken[0];
+
+		for (int i = 0; i < count; i++) {
+			int s = taken[i];
+
+			board->color[s] = (unsigned char)enemy;
+			board->head[s] = (short)h;
+			board->next[s] = taken[(i + 1) % count];
+			for (int j = 0; j < 4; j++) {
+				int n = s + m_neighbours[j];
+
+				if (board->color[n] == color)
+					RemoveLiberty(board, board->head[n], s);
+			}
+		}
+		board->stones[h] = (short)count;
+		board->libs[h] = 0;
+		board->libSum[h] = board->libSumSq[h] = 0;
+		taken += count;
+	}
+
+	// Crossing the ring ends back over splits each join, newest first.
+	for (int m = record->mergeCount - 1; m >= 0; m--) {
+		int a = record->merges[m][0], b = record->merges[m][1], s = b, t;
+
+		t = board->next[a];
+		board->next[a] = board->next[b];
+		board->next[b] = (short)t;
+		do {
+			board->head[s] = (short)b;
+			s = board->next[s];
+		} while (s != b);
+	}
+
+	board->color[p] = GO_EMPTY;
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+
+		if (board->color[n] == enemy)
+			AddLiberty(board, board->head[n], p);
+	}
+	for (int i = 0; i < record->ownCount; i++) {
+		int h = record->own[i];
+
+		board->stones[h] = record->ownStones[i];
+		board->libs[h] = record->ownLibs[i];
+		board->libSum[h] = record->ownLibSum[i];
+		board->libSumSq[h] = record->ownLibSumSq[i];
+	}
+}
+
+int GO_RemoveString(GoBoard *board, int p, short *removed)
+{
+	board->ko = GO_PASS;
+	return RemoveString(board, board->head[p], removed);
+}
+
+unsigned long long GO_HashAfter(const GoBoard *board, int p)
+{
+	int color = board->toMove, enemy = GO_OTHER(color);
+	unsigned long long hash = board->hash;
+	int taken[4];
+
+	if (p == GO_PASS)
+		return hash;
+	hash ^= StoneKey(color, p);
+
+	// Enemy strings down to their last liberty come off, each only once
+	// however many sides of p it touches.
+	for (int i = 0; i < 4; i++) {
+		int n = p + m_neighbours[i];
+		int h, s, j;
+
+		taken[i] = -1;
+		if (board->color[n] != enemy || !GO_InAtari(board, n))
+			continue;
+		h = s = board->head[n];
+		for (j = 0; j < i && taken[j] != h; j++)
+			;
+		taken[i] = h;
+		if (j < i)
+			continue;
+
+		do {
+			hash ^= StoneKey(enemy, s);
+			s = board->next[s];
+		} while (s != h);
+	}
+	return hash;
+}
+
+void GO_ResetHistory(GoHistory *history, const GoBoard *board)
+{
+	for (int i = 0; i < GO_HISTORYSIZE; i++)
+		history->keys[i] = 0;
+	history->count = 0;
+	GO_RecordPosition(history, board);
+}
+
+int GO_Seen(const GoHistory *history, unsigned long long key)
+{
+	for (unsigned int i = (unsigned int)key & (GO_HISTORYSIZE - 1); history->keys[i]; i = (i + 1) & (GO_HISTORYSIZE - 1)) {
+		if (history->keys[i] == key)
+			return 1;
+	}
+	return 0;
+}
+
+int GO_RecordPosition(GoHistory *history, const GoBoard *board)
+{
+	unsigned int i = (unsigned int)board->hash & (GO_HISTORYSIZE - 1);
+
+	for (; history->keys[i]; i = (i + 1) & (GO_HISTORYSIZE - 1)) {
+		if (history->keys[i] == board->hash)
+			return history->count < GO_MAXPOSITIONS;
+	}
+	if (history->count >= GO_MAXPOSITIONS)
+		return 0;
+
+	history->keys[i] = board->hash;
+	history->count++;
+	return history->count < GO_MAXPOSITIONS;
+}
+
+void GO_Score(const GoBoard *board, unsigned char owner[GO_POINTS], int score[3])
+{
+	short region[GO_MAXSTONES];
+
+	score[GO_BLACK] = score[GO_WHITE] = 0;
+	for (int p = 0; p < GO_POINTS; p++)
+		owner[p] = board->color[p] == GO_BORDER ? GO_EMPTY : GO_BORDER; // GO_BORDER until visited
+
+	for (int p = 0; p < GO_POINTS; p++) {
+		int count = 0, reach = 0, color;
+
+		if (owner[p] != GO_BORDER)
+			continue;
+		if (board->color[p] != GO_EMPTY) {
+			owner[p] = board->color[p];
+			score[owner[p]]++;
+			continue;
+		}
+
+		// The region list doubles as the flood's stack: everything before
+		// done has had its neighbours looked at.
+		region[count++] = (short)p;
+		owner[p] = GO_EMPTY;
+		for (int done = 0; done < count; done++) {
+			for (int i = 0; i < 4; i++) {
+				int n = region[done] + m_neighbours[i];
+
+				if (board->color[n] == GO_EMPTY) {
+					if (owner[n] == GO_BORDER) {
+						owner[n] = GO_EMPTY;
+						region[count++] = (short)n;
+					}
+				}
+				else if (board->color[n] != GO_BORDER)
+					reach |= board->color[n];
+			}
+		}
+
+		// reach is a mask of GO_BLACK and GO_WHITE, so one of them alone is that colour.
+		color = reach == GO_BLACK || reach == GO_WHITE ? reach : GO_EMPTY;
+		if (color != GO_EMPTY) {
+			for (int i = 0; i < count; i++)
+				owner[region[i]] = (unsigned char)color;
+			score[color] += count;
+		}
+	}
+}
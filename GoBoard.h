@@ -0,0 +1,214 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBoard.h
+//# Go rules on a padded one-dimensional board, with strings
+//# kept up to date as stones come and go.  Knows nothing about
+//# colours or LEDs, so the game, the AI and the host tools can
+//# all share it.
+//###############################################################
+#pragma once
+
+// Points are numbered row by row with a border all round, so the neighbours
+// of p are p - 1, p + 1, p - GO_STRIDE and p + GO_STRIDE and never need a
+// bounds check.  One border column serves as both the left and right edge.
+// Boards smaller than GO_MAXSIZE just have more of their points marked as
+// border.  Everything is sized for the biggest board at compile time, which is
+// the board the game plays on unless a build asks for more: the host tools
+// want -DGO_MAXSIZE=19 to look at the big boards from a 9x9 game.
+#ifndef GO_BOARDSIZE
+#define GO_BOARDSIZE 9
+#endif
+#ifndef GO_MAXSIZE
+#define GO_MAXSIZE GO_BOARDSIZE
+#endif
+#define GO_STRIDE (GO_MAXSIZE + 1)
+#define GO_POINTS ((GO_MAXSIZE + 2) * GO_STRIDE)
+#define GO_MAXSTONES (GO_MAXSIZE * GO_MAXSIZE)
+
+// Point 0 is border, so it doubles as the pass move.
+#define GO_PASS 0
+
+#define GO_EMPTY 0
+#define GO_BLACK 1   // player 1, who moves first
+#define GO_WHITE 2
+#define GO_BORDER 3
+#define GO_OTHER(COLOR) (3 - (COLOR))
+
+// Every stone belongs to a string, kept as a ring through next[] with all its
+// stones pointing at the same head.  The head carries the string's size and its
+// pseudo-liberties: each empty point counted once for every stone beside it.
+// Those can be kept exactly as stones come and go, and are 0 just when the
+// string has no liberties.  The sum and sum of squares of the points counted
+// tell whether they're all the same point, which is atari.
+typedef struct
+{
+	int size;
+	int toMove;                       // GO_BLACK or GO_WHITE
+	int ko;                           // point toMove may not retake, GO_PASS if none
+	int captures[3];                  // stones taken by each colour
+	unsigned long long hash;          // Zobrist key of the stones alone, kept up to date by every function here
+
+	unsigned char color[GO_POINTS];
+	short head[GO_POINTS];
+	short next[GO_POINTS];
+
+	// Only meaningful at a head.
+	short stones[GO_POINTS];
+	short libs[GO_POINTS];
+	int libSum[GO_POINTS];
+	int libSumSq[GO_POINTS];
+} GoBoard;
+
+// Positional superko: no move may bring back the stones of any earlier
+// position.  The keys of every position so far go in an open-addressed set.
+// Superko alone would let a game run for ever, so a game is over once it
+// has been through GO_MAXPOSITIONS positions, five for every point and far
+// longer than any real game.  The set is sized to be at most half full then.
+#define GO_MAXPOSITIONS (5 * GO_MAXSTONES)
+#define GO_HISTORYSIZE (GO_MAXPOSITIONS <= 256 ? 512 : GO_MAXPOSITIONS <= 512 ? 1024 : GO_MAXPOSITIONS <= 1024 ? 2048 : 4096)
+#if GO_MAXPOSITIONS > GO_HISTORYSIZE / 2
+#error GO_HISTORYSIZE is too small for GO_MAXPOSITIONS
+#endif
+
+typedef struct
+{
+	unsigned long long keys[GO_HISTORYSIZE]; // 0 for an empty slot
+	int count;
+} GoHistory;
+
+// Moves played with GO_MakeMove, so GO_UnmakeMove can take them back in
+// place.  Cheaper than copying the board for anything that reads a few
+// moves ahead and back again.  A move records how the strings around it
+// stood, which it joined and which it took, and their stones go in one pool
+// shared by the whole stack.
+#define GO_UNDODEPTH 128
+#define GO_UNDOSTONES (2 * GO_MAXSTONES)
+
+typedef struct
+{
+	short move;
+	short ko;
+	unsigned long long hash;
+	unsigned char ownCount;     // strings of the mover's beside the move, as they were
+	unsigned char mergeCount;
+	unsigned char takenCount;
+	short own[4];
+	short ownStones[4];
+	short ownLibs[4];
+	int ownLibSum[4];
+	int ownLibSumSq[4];
+	short merges[4][2];         // head kept, head joined to it, in the order joined
+	short taken[4];             // stones in each string taken, in order in GoUndo.stones
+	short takenTotal;
+} GoUndoMove;
+
+typedef struct
+{
+	GoUndoMove moves[GO_UNDODEPTH];
+	short stones[GO_UNDOSTONES];
+	int depth;
+	int stoneCount;
+} GoUndo;
+
+static inline int GO_Point(int x, int y)
+{
+	return (y + 1) * GO_STRIDE + x + 1;
+}
+
+static inline int GO_PointX(int p)
+{
+	return p % GO_STRIDE - 1;
+}
+
+static inline int GO_PointY(int p)
+{
+	return p / GO_STRIDE - 1;
+}
+
+// Whether the string through the stone on p is down to one liberty.
+static inline int GO_InAtari(const GoBoard *board, int p)
+{
+	int h = board->head[p];
+
+	return (long long)board->libs[h] * board->libSumSq[h] == (long long)board->libSum[h] * board->libSum[h];
+}
+
+// The last liberty of a string in atari.
+static inline int GO_AtariLiberty(const GoBoard *board, int p)
+{
+	int h = board->head[p];
+
+	return board->libSum[h] / board->libs[h];
+}
+
+// Whether the empty point p is an eye of color's: every neighbour is theirs or the edge, and
+// the other colour holds at most one diagonal, or none if p is on the edge.
+// Filling one can only hurt, so the computer player never does.
+int GO_IsEye(const GoBoard *board, int p, int color);
+
+// Empties a board of size x size points with black to move.  Returns 0 and
+// leaves the board alone if size is more than GO_MAXSIZE.
+int GO_Clear(GoBoard *board, int size);
+
+// Whether the side to move may play on p: it must be empty, not a ko retake
+// and not suicide.  Constant time.
+int GO_IsLegal(const GoBoard *board, int p);
+
+// Plays p, or GO_PASS, for the side to move and passes the turn.  p must be
+// legal.  Returns the number of stones captured, and lists their points in
+// captured if it isn't 0.  Takes time in proportion to the stones touched.
+int GO_Play(GoBoard *board, int p, short *captured);
+
+// Empties the stack.  The board it was used with should be back where it started.
+void GO_ResetUndo(GoUndo *undo);
+
+// GO_Play, and pushes what it takes to undo it.  p must be legal.  Returns
+// the number of stones captured, or -1 without playing if the stack is full.
+int GO_MakeMove(GoBoard *board, GoUndo *undo, int p);
+
+// Takes back the last move made with GO_MakeMove.  Time in proportion to the
+// stones it touched, as for the move.
+void GO_UnmakeMove(GoBoard *board, GoUndo *undo);
+
+// Takes the string through the stone on p off the board, as the players do
+// with dead stones once the game is over.  Nobody is credited with them and
+// the turn doesn't change.  Returns the number of stones and lists their
+// points in removed if it isn't 0.
+int GO_RemoveString(GoBoard *board, int p, short *removed);
+
+// Key the board would have after the side to move played p, which must be
+// legal.  Costs one step per stone it would capture.
+unsigned long long GO_HashAfter(const GoBoard *board, int p);
+
+// Starts the history off at board.
+void GO_ResetHistory(GoHistory *history, const GoBoard *board);
+
+// Whether a key has come up before.  Constant time.
+int GO_Seen(const GoHistory *history, unsigned long long key);
+
+// Adds the position reached by a move.  Returns 0 once the game has been
+// through GO_MAXPOSITIONS positions, when it must end: no more are taken.
+int GO_RecordPosition(GoHistory *history, const GoBoard *board);
+
+// Tromp-Taylor area score: each colour gets its stones plus every empty point
+// from which only its stones can be reached.  owner[p] is set to the colour
+// each point counts for, GO_EMPTY if neither, and score[GO_BLACK] and
+// score[GO_WHITE] to the totals.  One pass over the board.
+void GO_Score(const GoBoard *board, unsigned char owner[GO_POINTS], int score[3]);
@@ -0,0 +1,368 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoMCTS.c
+//# UCT with RAVE over GoPlayout playouts.  Every thread walks the
+//# same tree, adding to its statistics with atomic adds, and
+//# plays its playouts on a board of its own.
+//###############################################################
+#include "GoMCTS.h"
+#include "GoPlayout.h"
+#include "GoTactics.h"
+
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__unix__) || defined(__APPLE__))
+#include <pthread.h>
+#include <time.h>
+#define MCTS_PARALLEL 1
+#define AtomicAdd(VAR, N) __atomic_fetch_add(&(VAR), (N), __ATOMIC_RELAXED)
+#define AtomicFetchAdd(VAR, N) __atomic_fetch_add(&(VAR), (N), __ATOMIC_RELAXED)
+#define AtomicLoad(VAR) __atomic_load_n(&(VAR), __ATOMIC_ACQUIRE)
+#define AtomicStore(VAR, N) __atomic_store_n(&(VAR), (N), __ATOMIC_RELEASE)
+#define AtomicSwap(VAR, FROM, TO) AtomicSwapInt(&(VAR), FROM, TO)
+
+static int AtomicSwapInt(int *var, int from, int to)
+{
+	return __atomic_compare_exchange_n(var, &from, to, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static double NowMillis()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec * 1e-6;
+}
+#else
+// One thread and no clock: plain arithmetic does.
+#define MCTS_PARALLEL 0
+#define AtomicAdd(VAR, N) ((VAR) += (N))
+#define AtomicFetchAdd(VAR, N) (((VAR) += (N)) - (N))
+#define AtomicLoad(VAR) (VAR)
+#define AtomicStore(VAR, N) ((VAR) = (N))
+#define AtomicSwap(VAR, FROM, TO) ((VAR) == (FROM) ? ((VAR) = (TO), 1) : 0)
+#endif
+
+// Node states.  Only the thread that moves a node from LEAF to EXPANDING
+// makes its children, and nobody follows them until it's EXPANDED.
+#define NODE_LEAF 0
+#define NODE_EXPANDING 1
+#define NODE_EXPANDED 2
+#define NODE_FULL 3      // the pool ran out, so it stays a leaf
+
+// RAVE weighs the all-moves-as-first average against the node's own until it
+// has about this many visits of its own.
+#define RAVEEQUIVALENCE 1000.0f
+
+// Value of a move nothing is known about yet, so each gets tried once.
+#define FIRSTPLAYURGENCY 1.1f
+
+// Nodes to read each ladder at the root for.
+#define LADDERNODES 1000
+
+// Playouts to stop at when there's neither a playout limit nor a clock.
+#define DEFAULTPLAYOUTS 1000
+
+#define MAXPATH GO_MAXSTONES
+
+typedef struct
+{
+	const GoBoard *board;
+	const GoSearchLimits *limits;
+	GoNode *nodes;
+	unsigned long nodesUsed;
+	unsigned long playoutsStarted;
+	unsigned long playoutsDone;
+	int stop;
+#if MCTS_PARALLEL
+	double deadline;
+#endif
+} Search;
+
+typedef struct
+{
+	Search *search;
+	unsigned int random;
+} Worker;
+
+// Gives a node a child for every move worth playing: any legal point but the
+// mover's own eyes and points already settled, and passing.  At the root,
+// moves that repeat an earlier position are left out too, and so are those
+// marked in lost.  Nothing either side plays changes who a settled point
+// belongs to, and since neither plays on them in the tree, they stay settled
+// all the way down.
+static void Expand(Search *search, int node, const GoBoard *board, const GoHistory *history, const unsigned char *lost)
+{
+	GoNode *parent = &search->nodes[node];
+	const unsigned char *settled = search->limits->settled;
+	short moves[GO_MAXSTONES + 1];
+	int count = 0;
+	unsigned long first;
+
+	for (int p = 0; p < GO_POINTS; p++) {
+		if (board->color[p] != GO_EMPTY || GO_IsEye(board, p, board->toMove) || !GO_IsLegal(board, p))
+			continue;
+		if (settled && settled[p] != GO_EMPTY)
+			continue;
+		if (history && GO_Seen(history, GO_HashAfter(board, p)))
+			continue;
+		if (lost && lost[p])
+			continue;
+		moves[count++] = (short)p;
+	}
+	moves[count++] = GO_PASS;
+
+	first = AtomicFetchAdd(search->nodesUsed, (unsigned long)count);
+	if (first + count > search->limits->nodeCount) {
+		AtomicStore(parent->state, NODE_FULL);
+		return;
+	}
+
+	for (int i = 0; i < count; i++) {
+		GoNode *child = &search->nodes[first + i];
+
+		child->move = moves[i];
+		child->childCount = 0;
+		child->firstChild = 0;
+		child->state = NODE_LEAF;
+		child->visits = child->wins = 0;
+		child->raveVisits = child->raveWins = 0;
+	}
+	parent->firstChild = (int)first;
+	parent->childCount = (short)count;
+	AtomicStore(parent->state, NODE_EXPANDED);
+}
+
+// The child with the best blend of its own average and its RAVE average.
+// Exploration comes from the RAVE term and from virtual losses, so there's
+// no UCB bonus.
+static int Select(const Search *search, int node)
+{
+	const GoNode *parent = &search->nodes[node];
+	int best = parent->firstChild;
+	float bestValue = -1.0f;
+
+	for (int i = parent->firstChild; i < parent->firstChild + parent->childCount; i++) {
+		const GoNode *child = &search->nodes[i];
+		float n = (float)AtomicLoad(child->visits), w = (float)AtomicLoad(child->wins);
+		float rn = (float)AtomicLoad(child->raveVisits), rw = (float)AtomicLoad(child->raveWins);
+		float value;
+
+		if (rn > 0) {
+			float beta = rn / (rn + n + n * rn / RAVEEQUIVALENCE);
+
+			value = beta * rw / (2 * rn) + (n > 0 ? (1 - beta) * w / (2 * n) : 0);
+		}
+		else
+			value = n > 0 ? w / (2 * n) : FIRSTPLAYURGENCY;
+
+		if (value > bestValue) {
+			bestValue = value;
+			best = i;
+		}
+	}
+	return best;
+}
+
+// Adds a finished playout to every node on its path.  RAVE credits each
+// child of a node whose move its player went on to make first, anywhere
+// later in the game.
+static void Backup(Search *search, const int *path, int depth, const short *firstPly, int blackResult)
+{
+	int rootColor = search->board->toMove;
+
+	for (int i = 0; i < depth; i++) {
+		GoNode *node = &search->nodes[path[i]];
+		int toMove = i % 2 == 0 ? rootColor : GO_OTHER(rootColor);
+		int result = toMove == GO_BLACK ? blackResult : 2 - blackResult;
+
+		// The mover into node i is the player not to move there.
+		if (i > 0)
+			AtomicAdd(node->wins, 2 - result);
+
+		if (AtomicLoad(node->state) != NODE_EXPANDED)
+			continue;
+		for (int c = node->firstChild; c < node->firstChild + node->childCount; c++) {
+			GoNode *child = &search->nodes[c];
+			int ply = child->move == GO_PASS ? -1 : firstPly[child->move] - 1;
+
+			if (ply >= i && (ply - i) % 2 == 0) {
+				AtomicAdd(child->raveVisits, 1);
+				AtomicAdd(child->raveWins, result);
+			}
+		}
+	}
+}
+
+// One pass down the tree, a playout from where it stops, and the result back up.
+// The tree moves go through the playout too, so RAVE sees them.
+static void Iterate(Search *search, unsigned int *random)
+{
+	GoPlayout playout;
+	short firstPly[GO_POINTS];
+	int path[MAXPATH];
+	int depth = 0, node = 0;
+
+	GO_StartPlayout(&playout, search->board, search->limits->passes);
+	memset(firstPly, 0, sizeof(firstPly));
+	playout.firstPly = firstPly;
+	AtomicAdd(search->nodes[0].visits, 1);
+	path[depth++] = 0;
+
+	while (playout.passes < 2 && depth < MAXPATH) {
+		GoNode *current = &search->nodes[node];
+
+		if (AtomicLoad(current->state) != NODE_EXPANDED) {
+			if (AtomicLoad(current->visits) <= GO_EXPANDVISITS || !AtomicSwap(current->state, NODE_LEAF, NODE_EXPANDING))
+				break;
+			Expand(search, node, &playout.board, 0, 0);
+			if (AtomicLoad(current->state) != NODE_EXPANDED)
+				break;
+		}
+
+		node = Select(search, node);
+		AtomicAdd(search->nodes[node].visits, 1);
+		GO_PlayoutPlay(&playout, search->nodes[node].move);
+		path[depth++] = node;
+	}
+
+	Backup(search, path, depth, firstPly, GO_RunPlayout(&playout, GO_PLAYOUT_WEIGHTED, search->limits->komi, random));
+	AtomicAdd(search->playoutsDone, 1);
+}
+
+// Marks the liberty of each of the mover's strings in atari that a ladder
+// catches whichever way it runs.  Running there only feeds the other side
+// more stones, which a playout is slow to see but reading sees at once.
+static void FindLostLadders(const GoBoard *board, unsigned char lost[GO_POINTS])
+{
+	GoBoard copy = *board;
+	GoUndo undo;
+
+	GO_ResetUndo(&undo);
+	memset(lost, 0, GO_POINTS);
+	for (int p = 0; p < GO_POINTS; p++) {
+		GoReadResult result;
+
+		if (board->color[p] != board->toMove || board->head[p] != p || !GO_InAtari(board, p))
+			continue;
+		GO_ReadString(&copy, &undo, p, GO_LADDERLIBS, LADDERNODES, &result);
+		if (result.result == GO_READ_CAPTURED)
+			lost[GO_AtariLiberty(board, p)] = 1;
+	}
+}
+
+static int OutOfBudget(Search *search)
+{
+	const GoSearchLimits *limits = search->limits;
+	unsigned long maxPlayouts = limits->maxPlayouts;
+
+	if (!maxPlayouts && (!MCTS_PARALLEL || !limits->maxMillis))
+		maxPlayouts = DEFAULTPLAYOUTS;
+
+	if (AtomicLoad(search->stop))
+		return 1;
+	if (maxPlayouts && AtomicFetchAdd(search->playoutsStarted, 1) >= maxPlayouts)
+		return 1;
+#if MCTS_PARALLEL
+	if (limits->maxMillis && NowMillis() > search->deadline) {
+		AtomicStore(search->stop, 1);
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+static void *RunWorker(void *arg)
+{
+	Worker *worker = (Worker *)arg;
+
+	while (!OutOfBudget(worker->search))
+		Iterate(worker->search, &worker->random);
+	return 0;
+}
+
+void GO_Search(const GoBoard *board, const GoSearchLimits *limits, GoSearchResult *result)
+{
+	Search search;
+	Worker workers[GO_MAXTHREADS];
+	GoNode *root = &limits->nodes[0];
+	unsigned char lost[GO_POINTS];
+	int threads = limits->threads < 1 ? 1 : limits->threads > GO_MAXTHREADS ? GO_MAXTHREADS : limits->threads;
+	int best;
+
+	search.board = board;
+	search.limits = limits;
+	search.nodes = limits->nodes;
+	search.nodesUsed = 1;
+	search.playoutsStarted = search.playoutsDone = 0;
+	search.stop = 0;
+
+	root->move = GO_PASS;
+	root->state = NODE_EXPANDING;
+	root->visits = root->wins = 0;
+	root->raveVisits = root->raveWins = 0;
+	FindLostLadders(board, lost);
+	Expand(&search, 0, board, limits->history, lost);
+
+	// Only happens if the pool is smaller than it should be.
+	if (root->state != NODE_EXPANDED) {
+		result->move = GO_PASS;
+		result->winRate = 50;
+		result->playouts = result->nodes = 0;
+		return;
+	}
+
+	// Passing is all there is, so there's nothing to think about.
+	if (root->childCount > 1) {
+		for (int i = 0; i < threads; i++) {
+			workers[i].search = &search;
+			workers[i].random = (limits->seed + 1) * 0x9E3779B9u + i * 0x85EBCA6Bu;
+			if (!workers[i].random)
+				workers[i].random = 1;
+		}
+
+#if MCTS_PARALLEL
+		pthread_t ids[GO_MAXTHREADS];
+
+		search.deadline = NowMillis() + limits->maxMillis;
+		for (int i = 1; i < threads; i++) {
+			if (pthread_create(&ids[i], 0, RunWorker, &workers[i]) != 0)
+				threads = i;
+		}
+		RunWorker(&workers[0]);
+		for (int i = 1; i < threads; i++)
+			pthread_join(ids[i], 0);
+#else
+		RunWorker(&workers[0]);
+#endif
+	}
+
+	// The most searched move, which is the one the search trusts most.
+	best = root->firstChild;
+	for (int i = root->firstChild; i < root->firstChild + root->childCount; i++) {
+		if (limits->nodes[i].visits > limits->nodes[best].visits)
+			best = i;
+	}
+
+	result->move = limits->nodes[best].move;
+	result->winRate = limits->nodes[best].visits ? limits->nodes[best].wins * 50 / limits->nodes[best].visits : 50;
+	result->playouts = search.playoutsDone;
+	result->nodes = search.nodesUsed < limits->nodeCount ? search.nodesUsed : limits->nodeCount;
+}
@@ -0,0 +1,81 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoMCTS.h
+//# Computer opponent for Go: Monte Carlo tree search with RAVE,
+//# shared out over as many threads as the platform can give it.
+//# Works on GoBoard positions only, never on the LEDs.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+
+#define GO_MAXTHREADS 16
+
+// A node gets children once this many searches have passed through it.
+#define GO_EXPANDVISITS 8
+
+// Nodes that a search of PLAYOUTS playouts on a SIZE x SIZE board can need.
+// Only a leaf that GO_EXPANDVISITS playouts have already stopped at makes
+// children, one for each point and a pass at most, so the tree never fills.
+#define GO_SEARCHNODES(SIZE, PLAYOUTS) (((PLAYOUTS) / (GO_EXPANDVISITS + 1) + 1) * ((SIZE) * (SIZE) + 1))
+
+// A node stands for the move that reaches it.  All its children are made at
+// once, after a few searches have come back through it, and sit next to each
+// other in the pool.
+//
+// The statistics are shared by every thread and only ever added to, so they
+// need no locks.  A thread counts its visit on the way down, before its
+// playout has a result, which makes the node look like a loss to the others
+// until then and spreads them out over the tree (virtual loss).
+typedef struct
+{
+	short move;        // a point, or GO_PASS
+	short childCount;
+	int firstChild;    // index in the pool
+	int state;         // see GoMCTS.c
+	int visits;
+	int wins;          // in half points for the player who made the move: 2 for a win, 1 for a tie
+	int raveVisits;    // playouts through the parent in which this player went on to play move
+	int raveWins;
+} GoNode;
+
+typedef struct
+{
+	GoNode *nodes;             // the tree, owned by whoever is searching
+	unsigned long nodeCount;   // at least GO_MAXSTONES + 2.  Once it's full the tree stops growing; see GO_SEARCHNODES.
+	unsigned long maxPlayouts; // 0 for no limit
+	long maxMillis;            // 0 for no limit.  Ignored where there's no clock to read; then maxPlayouts must be set.
+	int threads;               // 1 to GO_MAXTHREADS.  Only 1 gives the same move every time.
+	int komi;                  // in half points, added to white's score
+	int passes;                // passes in a row just before the position, so the search knows a pass could end the game
+	const GoHistory *history;  // positions the move may not bring back.  May be 0.
+	const unsigned char *settled; // points not worth playing on, GO_EMPTY where they are, as GoBenson.owner.  May be 0.
+	unsigned int seed;
+} GoSearchLimits;
+
+typedef struct
+{
+	int move;               // a point, or GO_PASS
+	int winRate;            // percent, for the side to move
+	unsigned long playouts;
+	unsigned long nodes;
+} GoSearchResult;
+
+// Picks a move for the side to move.  There's always one, since passing is always legal.
+void GO_Search(const GoBoard *board, const GoSearchLimits *limits, GoSearchResult *result);
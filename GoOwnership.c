@@ -0,0 +1,168 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoOwnership.c
+//# Each thread plays its share of the playouts on a board of its
+//# own and keeps its own tally, so nothing is shared until the
+//# tallies are added up at the end.
+//###############################################################
+#include "GoOwnership.h"
+#include "GoPlayout.h"
+
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__unix__) || defined(__APPLE__))
+#include <pthread.h>
+#include <time.h>
+#define OWNERSHIP_PARALLEL 1
+
+static double NowMillis()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec * 1e-6;
+}
+#else
+#define OWNERSHIP_PARALLEL 0
+#endif
+
+typedef struct
+{
+	const GoBoard *board;
+	unsigned long playouts; // in all
+	int first;              // this worker plays first, first + step, first + 2 * step...
+	int step;
+	unsigned int seed;
+#if OWNERSHIP_PARALLEL
+	long maxMillis;
+	double deadline;
+#endif
+	unsigned long done;
+	int tally[GO_POINTS];   // playouts black owned each point in, less those white did
+} Worker;
+
+// Random numbers for one playout, from the seed and its number alone.
+static unsigned int PlayoutSeed(unsigned int seed, unsigned long n)
+{
+	unsigned int x = seed * 0x9E3779B9u + (unsigned int)n * 0x85EBCA6Bu;
+
+	x ^= x >> 16;
+	x *= 0x7FEB352Du;
+	x ^= x >> 15;
+	return x ? x : 1;
+}
+
+static void *RunWorker(void *arg)
+{
+	Worker *worker = (Worker *)arg;
+	GoPlayout playout;
+	unsigned char owner[GO_POINTS];
+	int score[3];
+
+	for (unsigned long n = worker->first; n < worker->playouts; n += worker->step) {
+		unsigned int random = PlayoutSeed(worker->seed, n);
+
+#if OWNERSHIP_PARALLEL
+		if (worker->maxMillis && NowMillis() > worker->deadline)
+			break;
+#endif
+		GO_StartPlayout(&playout, worker->board, 0);
+		GO_RunPlayout(&playout, GO_PLAYOUT_WEIGHTED, 0, &random);
+		GO_Score(&playout.board, owner, score);
+
+		for (int p = 0; p < GO_POINTS; p++) {
+			if (owner[p] == GO_BLACK)
+				worker->tally[p]++;
+			else if (owner[p] == GO_WHITE)
+				worker->tally[p]--;
+		}
+		worker->done++;
+	}
+	return 0;
+}
+
+unsigned long GO_EstimateOwnership(const GoBoard *board, const GoOwnershipLimits *limits, short ownership[GO_POINTS])
+{
+	Worker workers[GO_MAXTHREADS];
+	int threads = limits->threads < 1 ? 1 : limits->threads > GO_MAXTHREADS ? GO_MAXTHREADS : limits->threads;
+	unsigned long playouts = limits->playouts ? limits->playouts : GO_DEFAULTOWNERSHIPPLAYOUTS;
+	unsigned long done = 0;
+
+	for (int i = 0; i < threads; i++) {
+		workers[i].board = board;
+		workers[i].playouts = playouts;
+		workers[i].first = i;
+		workers[i].step = threads;
+		workers[i].seed = limits->seed;
+		workers[i].done = 0;
+		memset(workers[i].tally, 0, sizeof(workers[i].tally));
+	}
+
+#if OWNERSHIP_PARALLEL
+	pthread_t ids[GO_MAXTHREADS];
+	int started[GO_MAXTHREADS];
+	double deadline = NowMillis() + limits->maxMillis;
+
+	for (int i = 0; i < threads; i++) {
+		workers[i].maxMillis = limits->maxMillis;
+		workers[i].deadline = deadline;
+	}
+
+	// Any share a thread can't be had for is played here after our own.
+	for (int i = 1; i < threads; i++)
+		started[i] = pthread_create(&ids[i], 0, RunWorker, &workers[i]) == 0;
+	RunWorker(&workers[0]);
+	for (int i = 1; i < threads; i++) {
+		if (started[i])
+			pthread_join(ids[i], 0);
+		else
+			RunWorker(&workers[i]);
+	}
+#else
+	for (int i = 0; i < threads; i++)
+		RunWorker(&workers[i]);
+#endif
+
+	for (int i = 0; i < threads; i++)
+		done += workers[i].done;
+
+	for (int p = 0; p < GO_POINTS; p++) {
+		long tally = 0;
+
+		for (int i = 0; i < threads; i++)
+			tally += workers[i].tally[p];
+		ownership[p] = (short)(done ? tally * GO_OWNERSHIPSCALE / (long)done : 0);
+	}
+	return done;
+}
+
+int GO_IsDead(const GoBoard *board, const short ownership[GO_POINTS], int p)
+{
+	int h = board->head[p], s = h;
+	long sum = 0;
+
+	// Summed from the string's own side, so dead is negative for either colour.
+	do {
+		sum += board->color[h] == GO_BLACK ? ownership[s] : -ownership[s];
+		s = board->next[s];
+	} while (s != h);
+
+	return sum <= -(long)GO_DEADOWNERSHIP * board->stones[h];
+}
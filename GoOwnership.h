@@ -0,0 +1,55 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoOwnership.h
+//# Who each point of a finished Go game really belongs to, found
+//# by playing it out many times, so dead stones can come off
+//# before the score is counted.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+#include "GoMCTS.h"
+
+// Ownership runs from -GO_OWNERSHIPSCALE, white's in every playout, to
+// GO_OWNERSHIPSCALE, black's in every playout.
+#define GO_OWNERSHIPSCALE 100
+
+// A string is dead when its points end up the other colour's by at least
+// this much: white's in 65 playouts in a hundred against black's in 35, say.
+// Seki comes out near 0, so it stays on the board.
+#define GO_DEADOWNERSHIP 30
+
+typedef struct
+{
+	unsigned long playouts; // 0 for GO_DEFAULTOWNERSHIPPLAYOUTS
+	long maxMillis;         // 0 for no limit.  Ignored where there's no clock to read.
+	int threads;            // 1 to GO_MAXTHREADS
+	unsigned int seed;
+} GoOwnershipLimits;
+
+#define GO_DEFAULTOWNERSHIPPLAYOUTS 1000
+
+// Plays board out with the weighted policy and sets ownership[p] for every
+// point on it.  Each playout seeds its own random numbers from seed and its
+// number, so the thread count doesn't change the answer unless the clock
+// runs out.  Returns the number of playouts, 0 leaving ownership all 0.
+unsigned long GO_EstimateOwnership(const GoBoard *board, const GoOwnershipLimits *limits, short ownership[GO_POINTS]);
+
+// Whether the string through the stone on p is dead by ownership.
+int GO_IsDead(const GoBoard *board, const short ownership[GO_POINTS], int p);
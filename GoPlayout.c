@@ -0,0 +1,177 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoPlayout.c
+//# The playout kernel.  Everything a move needs is a lookup: the
+//# empty list to draw from, GoBoard's pseudo-liberties for
+//# legality and atari, and a neighbour test for eyes.
+//###############################################################
+#include "GoPlayout.h"
+
+static const int m_neighbours[4] = { -GO_STRIDE, 1, GO_STRIDE, -1 };
+
+static unsigned int Random(unsigned int *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+static void AddEmpty(GoPlayout *playout, int p)
+{
+	playout->emptyIndex[p] = (short)playout->emptyCount;
+	playout->empty[playout->emptyCount++] = (short)p;
+}
+
+static void RemoveEmpty(GoPlayout *playout, int p)
+{
+	int i = playout->emptyIndex[p], last = playout->empty[--playout->emptyCount];
+
+	playout->empty[i] = (short)last;
+	playout->emptyIndex[last] = (short)i;
+}
+
+void GO_StartPlayout(GoPlayout *playout, const GoBoard *board, int passes)
+{
+	playout->board = *board;
+	playout->passes = passes;
+	playout->ply = 0;
+	playout->lastMove = GO_PASS;
+	playout->stones[GO_BLACK] = playout->stones[GO_WHITE] = 0;
+	playout->emptyCount = 0;
+	playout->firstPly = 0;
+
+	for (int p = 0; p < GO_POINTS; p++) {
+		int c = board->color[p];
+
+		if (c == GO_EMPTY)
+			AddEmpty(playout, p);
+		else if (c != GO_BORDER)
+			playout->stones[c]++;
+	}
+}
+
+void GO_PlayoutPlay(GoPlayout *playout, int p)
+{
+	short captured[GO_MAXSTONES];
+	int color = playout->board.toMove, count;
+
+	playout->ply++;
+	playout->lastMove = p;
+	if (p == GO_PASS) {
+		GO_Play(&playout->board, GO_PASS, 0);
+		playout->passes++;
+		return;
+	}
+
+	playout->passes = 0;
+	if (playout->firstPly && !playout->firstPly[p])
+		playout->firstPly[p] = (short)playout->ply;
+
+	count = GO_Play(&playout->board, p, captured);
+	RemoveEmpty(playout, p);
+	playout->stones[color]++;
+	playout->stones[GO_OTHER(color)] -= count;
+	for (int i = 0; i < count; i++)
+		AddEmpty(playout, captured[i]);
+}
+
+// The liberty of an enemy string next to the last move that it left in atari, or GO_PASS.
+static int CaptureMove(const GoPlayout *playout)
+{
+	const GoBoard *board = &playout->board;
+	int last = playout->lastMove;
+
+	if (last == GO_PASS)
+		return GO_PASS;
+
+	// The last move's own string can be in atari too: it may have been a self-atari.
+	for (int i = -1; i < 4; i++) {
+		int n = i < 0 ? last : last + m_neighbours[i];
+
+		if (board->color[n] == GO_OTHER(board->toMove) && GO_InAtari(board, n)) {
+			int p = GO_AtariLiberty(board, n);
+
+			if (GO_IsLegal(board, p))
+				return p;
+		}
+	}
+	return GO_PASS;
+}
+
+int GO_PlayoutMove(GoPlayout *playout, int policy, unsigned int *random)
+{
+	const GoBoard *board = &playout->board;
+	int move = GO_PASS;
+
+	if (policy == GO_PLAYOUT_WEIGHTED)
+		move = CaptureMove(playout);
+
+	// Walk the empty list round from a random start until a move will do.
+	if (move == GO_PASS && playout->emptyCount) {
+		int start = Random(random) % playout->emptyCount, i = start;
+
+		do {
+			int p = playout->empty[i];
+
+			if (!GO_IsEye(board, p, board->toMove) && GO_IsLegal(board, p)) {
+				move = p;
+				break;
+			}
+			if (++i == playout->emptyCount)
+				i = 0;
+		} while (i != start);
+	}
+
+	GO_PlayoutPlay(playout, move);
+	return move;
+}
+
+int GO_RunPlayout(GoPlayout *playout, int policy, int komi, unsigned int *random)
+{
+	int limit = playout->ply + 3 * playout->board.size * playout->board.size;
+
+	while (playout->passes < 2 && playout->ply < limit)
+		GO_PlayoutMove(playout, policy, random);
+	return GO_PlayoutResult(playout, komi);
+}
+
+int GO_PlayoutResult(const GoPlayout *playout, int komi)
+{
+	const GoBoard *board = &playout->board;
+	int score[3], margin;
+
+	score[GO_BLACK] = playout->stones[GO_BLACK];
+	score[GO_WHITE] = playout->stones[GO_WHITE];
+	for (int i = 0; i < playout->emptyCount; i++) {
+		int p = playout->empty[i], seen = 0;
+
+		for (int j = 0; j < 4; j++) {
+			int c = board->color[p + m_neighbours[j]];
+
+			if (c != GO_BORDER)
+				seen |= c;
+		}
+		if (seen == GO_BLACK || seen == GO_WHITE)
+			score[seen]++;
+	}
+	margin = 2 * (score[GO_BLACK] - score[GO_WHITE]) - komi;
+	return margin > 0 ? 2 : margin == 0 ? 1 : 0;
+}
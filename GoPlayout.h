@@ -0,0 +1,67 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoPlayout.h
+//# Plays Go games out to the end as fast as possible, for the
+//# computer player and anything else that needs to guess who a
+//# position belongs to.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+
+// Policies for choosing moves.  Light is uniformly random over the legal
+// moves that don't fill the mover's own eye.  Weighted first takes any
+// stones the last move left in atari, then falls back to light.
+#define GO_PLAYOUT_LIGHT 0
+#define GO_PLAYOUT_WEIGHTED 1
+
+// A board plus a list of its empty points, kept in step as stones go on
+// and come off so moves are drawn from it without scanning the board.
+typedef struct
+{
+	GoBoard board;
+	int passes;                     // in a row, the game is over at 2
+	int ply;                        // moves played since GO_StartPlayout
+	int lastMove;
+	int stones[3];                  // on the board, by colour
+	int emptyCount;
+	short empty[GO_MAXSTONES];
+	short emptyIndex[GO_POINTS];    // where each empty point is in empty
+	short *firstPly;                // if not 0, set to ply + 1 the first time each point is played
+} GoPlayout;
+
+// Copies board to start playing out from.  passes is how many passes in a row led up to it.
+void GO_StartPlayout(GoPlayout *playout, const GoBoard *board, int passes);
+
+// Plays p, which must be legal, or GO_PASS.
+void GO_PlayoutPlay(GoPlayout *playout, int p);
+
+// Picks a move for the side to move by policy and plays it.  Passes only
+// when nothing else will do.  Returns the move.
+int GO_PlayoutMove(GoPlayout *playout, int policy, unsigned int *random);
+
+// Plays on until both sides pass or the game has gone on three times as
+// many moves as there are points.  Returns black's result, as below.
+int GO_RunPlayout(GoPlayout *playout, int policy, int komi, unsigned int *random);
+
+// Black's result in half points, with komi in half points added to white's
+// score: 2 for a win, 1 for a tie, 0 for a loss.  Scores by area, taking
+// each empty point for whoever has stones next to it if only one does.  That
+// is exact once a playout has run to the end, when only eyes are left empty.
+int GO_PlayoutResult(const GoPlayout *playout, int komi);
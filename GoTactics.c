@@ -0,0 +1,245 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoTactics.c
+//# A plain and/or search.  Liberties are counted exactly by
+//# walking the string, stopping as soon as there are too many
+//# for the answer to matter.
+//###############################################################
+#include "GoTactics.h"
+
+static const int m_neighbours[4] = { -GO_STRIDE, 1, GO_STRIDE, -1 };
+
+// Candidate moves for one node.  Liberties of the string, then liberties of
+// up to MAXNEIGHBOURS attacking strings.
+#define MAXNEIGHBOURS 8
+#define MAXCANDIDATES (GO_RACELIBS + 1 + MAXNEIGHBOURS * (GO_RACELIBS + 1))
+
+typedef struct
+{
+	GoBoard *board;
+	GoUndo *undo;
+	int target;          // any stone of the string, which stays put while it's on the board
+	int maxLibs;
+	unsigned long nodes;
+	unsigned long maxNodes;
+	int outOfBudget;
+} Reader;
+
+// Up to max + 1 distinct liberties of the string through p, into libs.
+// Returns how many were found, so more than max means "too many to list".
+// Strings in atari, which a ladder is full of, don't need walking.
+static int Liberties(const GoBoard *board, int p, short *libs, int max)
+{
+	int h = board->head[p], s = h, count = 0;
+
+	if (GO_InAtari(board, h)) {
+		libs[0] = (short)GO_AtariLiberty(board, h);
+		return 1;
+	}
+
+	do {
+		for (int i = 0; i < 4; i++) {
+			int n = s + m_neighbours[i], j = 0;
+
+			if (board->color[n] != GO_EMPTY)
+				continue;
+			while (j < count && libs[j] != n)
+				j++;
+			if (j == count) {
+				libs[count++] = (short)n;
+				if (count > max)
+					return count;
+			}
+		}
+		s = board->next[s];
+	} while (s != h);
+	return count;
+}
+
+static int EmptyAround(const GoBoard *board, int p)
+{
+	int count = 0;
+
+	for (int i = 0; i < 4; i++)
+		count += board->color[p + m_neighbours[i]] == GO_EMPTY;
+	return count;
+}
+
+static void AddCandidate(short *moves, int *count, int p)
+{
+	for (int i = 0; i < *count; i++) {
+		if (moves[i] == p)
+			return;
+	}
+	moves[(*count)++] = (short)p;
+}
+
+static int Make(Reader *reader, int p)
+{
+	if (reader->outOfBudget || ++reader->nodes > reader->maxNodes || GO_MakeMove(reader->board, reader->undo, p) < 0) {
+		reader->outOfBudget = 1;
+		return 0;
+	}
+	return 1;
+}
+
+static int CanEscape(Reader *reader, int *move);
+
+// Whether the attacker, to move, can take the target.
+static int CanCapture(Reader *reader, int *move)
+{
+	GoBoard *board = reader->board;
+	short libs[GO_RACELIBS + 1];
+	int count = Liberties(board, reader->target, libs, reader->maxLibs);
+
+	if (count > reader->maxLibs)
+		return 0;
+
+	// Blocking where the string would gain most is usually right, so a
+	// ladder reads with hardly a wrong turn.
+	if (count == 2 && EmptyAround(board, libs[1]) > EmptyAround(board, libs[0])) {
+		short t = libs[0];
+
+		libs[0] = libs[1];
+		libs[1] = t;
+	}
+
+	for (int i = 0; i < count; i++) {
+		int escaped;
+
+		if (!GO_IsLegal(board, libs[i]) || !Make(reader, libs[i]))
+			continue;
+		escaped = board->color[reader->target] != GO_EMPTY && CanEscape(reader, 0);
+		GO_UnmakeMove(board, reader->undo);
+
+		// Out of nodes, nothing found below can be trusted, so give the
+		// defender the benefit of the doubt all the way up.
+		if (reader->outOfBudget)
+			return 0;
+		if (!escaped) {
+			if (move)
+				*move = libs[i];
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Whether the defender, to move, can save the target.
+static int CanEscape(Reader *reader, int *move)
+{
+	GoBoard *board = reader->board;
+	short libs[GO_RACELIBS + 1], moves[MAXCANDIDATES], heads[MAXNEIGHBOURS];
+	int count = Liberties(board, reader->target, libs, reader->maxLibs);
+	int moveCount = 0, headCount = 0, color = board->color[reader->target];
+	int h = board->head[reader->target], s = h;
+
+	if (count > reader->maxLibs) {
+		if (move)
+			*move = GO_PASS;
+		return 1;
+	}
+
+	// Attacking strings with no more liberties than the target can be taken
+	// or raced, so their liberties are worth trying.
+	do {
+		for (int i = 0; i < 4; i++) {
+			int n = s + m_neighbours[i], nh, j = 0;
+
+			if (board->color[n] != GO_OTHER(color))
+				continue;
+			nh = board->head[n];
+			while (j < headCount && heads[j] != nh)
+				j++;
+			if (j < headCount || headCount == MAXNEIGHBOURS)
+				continue;
+			heads[headCount++] = (short)nh;
+
+			// With the target in atari only taking one in atari will do, and
+			// that needs no walk.
+			if (count == 1) {
+				if (GO_InAtari(board, nh))
+					AddCandidate(moves, &moveCount, GO_AtariLiberty(board, nh));
+			}
+			else {
+				short theirs[GO_RACELIBS + 1];
+				int theirCount = Liberties(board, nh, theirs, count);
+
+				if (theirCount <= count) {
+					for (int k = 0; k < theirCount; k++)
+						AddCandidate(moves, &moveCount, theirs[k]);
+				}
+			}
+		}
+		s = board->next[s];
+	} while (s != h);
+	for (int i = 0; i < count; i++)
+		AddCandidate(moves, &moveCount, libs[i]);
+
+	for (int i = 0; i < moveCount; i++) {
+		int caught;
+
+		if (!GO_IsLegal(board, moves[i]) || !Make(reader, moves[i]))
+			continue;
+		caught = CanCapture(reader, 0);
+		GO_UnmakeMove(board, reader->undo);
+
+		if (reader->outOfBudget)
+			return 1;
+		if (!caught) {
+			if (move)
+				*move = moves[i];
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void GO_ReadString(GoBoard *board, GoUndo *undo, int p, int maxLibs, unsigned long maxNodes, GoReadResult *result)
+{
+	Reader reader;
+	int move = GO_PASS, done;
+
+	reader.board = board;
+	reader.undo = undo;
+	reader.target = p;
+	reader.maxLibs = maxLibs < 1 ? 1 : maxLibs > GO_RACELIBS ? GO_RACELIBS : maxLibs;
+	reader.nodes = 0;
+	reader.maxNodes = maxNodes ? maxNodes : GO_DEFAULTREADNODES;
+	reader.outOfBudget = 0;
+
+	if (board->color[p] == board->toMove) {
+		done = CanEscape(&reader, &move);
+		result->result = done ? GO_READ_ESCAPES : GO_READ_CAPTURED;
+	}
+	else {
+		done = CanCapture(&reader, &move);
+		result->result = done ? GO_READ_CAPTURED : GO_READ_ESCAPES;
+	}
+	if (reader.outOfBudget) {
+		result->result = GO_READ_UNKNOWN;
+		move = GO_PASS;
+	}
+	else if (!done)
+		move = GO_PASS;
+
+	result->move = move;
+	result->nodes = reader.nodes;
+}
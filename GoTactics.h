@@ -0,0 +1,59 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoTactics.h
+//# Reads out whether a string can be captured: ladders, and
+//# liberty races between it and the strings pressing on it.
+//# Plays on the board itself and takes every move back.
+//###############################################################
+#pragma once
+#include "GoBoard.h"
+
+// Liberties at which a string counts as getting away.  Ladders only ever
+// leave the string two, so reading with GO_LADDERLIBS says whether one
+// works.  Liberty races need a few more to settle.
+#define GO_LADDERLIBS 2
+#define GO_RACELIBS 4
+
+// Nodes for a read to give up at.  A ladder across a 19x19 board takes a
+// hundred or so.
+#define GO_DEFAULTREADNODES 5000
+
+#define GO_READ_ESCAPES 0
+#define GO_READ_CAPTURED 1
+#define GO_READ_UNKNOWN 2  // ran out of nodes or undo stack first
+
+typedef struct
+{
+	int result;          // GO_READ_*
+	int move;            // the move that does it for the side to move, or GO_PASS if none is needed or none works
+	unsigned long nodes; // moves tried
+} GoReadResult;
+
+// Reads the string through the stone on p with the side to move playing
+// first.  If it's theirs the question is whether they can save it, and if
+// it's the other side's, whether they can take it.  The attacker only plays
+// on the string's liberties.  The defender plays there too, and on the
+// liberties of the attacking strings around it with no more liberties than
+// it has, which takes in captures and liberty races.  The string gets away
+// once it has more than maxLibs liberties.
+//
+// board is played on with undo and put back as it was.  Deep reads need most
+// of the stack, so undo should hold few moves, if any.  Superko is not checked.
+void GO_ReadString(GoBoard *board, GoUndo *undo, int p, int maxLibs, unsigned long maxNodes, GoReadResult *result);
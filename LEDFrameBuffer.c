@@ -0,0 +1,131 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# LEDFrameBuffer.c
+//# Double buffered LED output.  Games draw into the pending frame
+//# as often as they like, and FB_Commit diffs it against what was
+//# last sent so each cell crosses the LED bus at most once.
+//###############################################################
+#include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+
+#include <string.h>
+
+void FB_SetBoardSize(LEDFrameBuffer *fb, int width, int height)
+{
+	if (width > FB_MAXSIZE)
+		width = FB_MAXSIZE;
+	if (height > FB_MAXSIZE)
+		height = FB_MAXSIZE;
+
+	SetBoardSize(width, height);
+
+	fb->width = (unsigned char)width;
+	fb->height = (unsigned char)height;
+	memset(fb->dirty, 0, sizeof(fb->dirty));
+	fb->dirtyCount = 0;
+	fb->bFilled = 0;
+
+	// The hardware could be showing anything after a resize.
+	fb->bStale = 1;
+}
+
+void FB_IlluminateBoard(LEDFrameBuffer *fb, int color)
+{
+	memset(fb->pending, color, sizeof(fb->pending));
+
+	// Every cell is dirty now, so the list is no use until the next commit.
+	memset(fb->dirty, 0, sizeof(fb->dirty));
+	fb->dirtyCount = 0;
+	fb->fillColor = (unsigned char)color;
+	fb->bFilled = 1;
+}
+
+void FB_IlluminateButton(LEDFrameBuffer *fb, int x, int y, int color)
+{
+	if (x < 0 || y < 0 || x >= fb->width || y >= fb->height)
+		return;
+
+	fb->pending[x][y] = (unsigned char)color;
+
+	if (!fb->bFilled && !fb->bStale && !fb->dirty[x][y]) {
+		fb->dirty[x][y] = 1;
+		fb->dirtyList[fb->dirtyCount++] = (unsigned short)(x * FB_MAXSIZE + y);
+	}
+}
+
+static void PushCell(LEDFrameBuffer *fb, int x, int y)
+{
+	IlluminateButton(x, y, fb->pending[x][y]);
+	fb->committed[x][y] = fb->pending[x][y];
+}
+
+// Full redraw after a fill or resize.  After a fill, uses IlluminateBoard when one
+// board write plus the cells that differ from the fill is cheaper than a plain diff.
+static void CommitWholeBoard(LEDFrameBuffer *fb)
+{
+	if (fb->bFilled) {
+		int changed = 0, offFill = 0;
+
+		if (!fb->bStale) {
+			for (int i = 0; i < fb->width; i++) {
+				for (int j = 0; j < fb->height; j++) {
+					if (fb->pending[i][j] != fb->committed[i][j])
+						changed++;
+					if (fb->pending[i][j] != fb->fillColor)
+						offFill++;
+				}
+			}
+		}
+
+		if (fb->bStale || offFill + 1 < changed) {
+			IlluminateBoard(fb->fillColor);
+			memset(fb->committed, fb->fillColor, sizeof(fb->committed));
+			fb->bStale = 0;
+		}
+	}
+
+	for (int i = 0; i < fb->width; i++) {
+		for (int j = 0; j < fb->height; j++) {
+			if (fb->bStale || fb->pending[i][j] != fb->committed[i][j])
+				PushCell(fb, i, j);
+		}
+	}
+}
+
+void FB_Commit(LEDFrameBuffer *fb)
+{
+	if (fb->bFilled || fb->bStale) {
+		CommitWholeBoard(fb);
+	}
+	else {
+		for (int i = 0; i < fb->dirtyCount; i++) {
+			int x = fb->dirtyList[i] / FB_MAXSIZE;
+			int y = fb->dirtyList[i] % FB_MAXSIZE;
+
+			fb->dirty[x][y] = 0;
+			if (fb->pending[x][y] != fb->committed[x][y])
+				PushCell(fb, x, y);
+		}
+	}
+
+	fb->dirtyCount = 0;
+	fb->bFilled = 0;
+	fb->bStale = 0;
+}
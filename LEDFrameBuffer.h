@@ -0,0 +1,50 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# LEDFrameBuffer.h
+//# Buffers LED writes made during a callback and pushes only the
+//# cells that actually changed when the callback commits.
+//###############################################################
+#pragma once
+
+// Largest board any game uses.
+#define FB_MAXSIZE 19
+
+typedef struct
+{
+	unsigned char width, height;
+	unsigned char pending[FB_MAXSIZE][FB_MAXSIZE];   // what the game has drawn so far
+	unsigned char committed[FB_MAXSIZE][FB_MAXSIZE]; // what the LEDs are showing
+	unsigned char dirty[FB_MAXSIZE][FB_MAXSIZE];     // 1 if the cell is in dirtyList
+
+	unsigned short dirtyList[FB_MAXSIZE * FB_MAXSIZE];
+	unsigned short dirtyCount;
+
+	unsigned char fillColor;
+	unsigned char bFilled; // 1 if IlluminateBoard was called since the last commit
+	unsigned char bStale;  // 1 if we can't trust committed, e.g. right after a resize
+} LEDFrameBuffer;
+
+// Same as the hardware calls, but nothing reaches the LEDs until FB_Commit.
+void FB_SetBoardSize(LEDFrameBuffer *fb, int width, int height);
+void FB_IlluminateBoard(LEDFrameBuffer *fb, int color);
+void FB_IlluminateButton(LEDFrameBuffer *fb, int x, int y, int color);
+
+// Sends every cell that differs from the last commit to the LEDs.  Call once at the end of each callback.
+void FB_Commit(LEDFrameBuffer *fb);
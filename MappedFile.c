@@ -0,0 +1,65 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# MappedFile.c
+//# mmap where there is one.  Elsewhere nothing maps, and the
+//# data has to be handed over in memory instead.
+//###############################################################
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MF_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const void *MF_Map(const char *path, size_t *size)
+{
+#ifdef MF_MMAP
+	struct stat info;
+	void *data;
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0)
+		return 0;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		close(fd);
+		return 0;
+	}
+	data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return 0;
+
+	*size = (size_t)info.st_size;
+	return data;
+#else
+	return 0;
+#endif
+}
+
+void MF_Unmap(const void *data, size_t size)
+{
+#ifdef MF_MMAP
+	if (data)
+		munmap((void *)data, size);
+#endif
+}
@@ -0,0 +1,32 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# MappedFile.h
+//# Read-only file mappings for data the games look things up in,
+//# like the Checkers endgame tables and opening book.  Mapping
+//# costs nothing up front and every table shares the pages.
+//###############################################################
+#pragma once
+
+#include <stddef.h>
+
+// Returns the file's contents and sets *size, or returns 0 if it can't be mapped,
+// is empty, or this platform can't map files.
+const void *MF_Map(const char *path, size_t *size);
+void MF_Unmap(const void *data, size_t size);
@@ -21,6 +21,8 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 //###############################################################
 #pragma once
 #include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+#include "GameContext.h"
 
 // Ensures that all game functions are unique and won't generate linker errors.
 // Assign a gamecode by changing the text before the ## symbols.  Use format [Three Letters]_
@@ -46,23 +48,50 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 #define MSLOT_G_RESTART 0
 #define MSLOT_G_RECONFIGURE 1
 
-// Gameplay Variables
-static unsigned char m_bIsSetup; // 1 if setup phase, 0 if game phase.
-static unsigned char m_iBoardSize;
+// Gameplay Variables.  One set per table, see GameContext.h.
+typedef struct
+{
+	unsigned char bIsSetup; // 1 if setup phase, 0 if game phase.
+	unsigned char iBoardSize;
+
+	int turnCount;
+
+	// Everything we draw goes through here and reaches the LEDs once per callback.
+	LEDFrameBuffer frameBuffer;
 
-static int turnCount = 0;
+	// The board is kept here and the LEDs only ever show it, never get read back.
+	unsigned char board[LIGHTSBOARDCOLSIZE][LIGHTSBOARDROWSIZE]; // piece color in each slot, OFFCOLOR if empty
+} PopoutContext;
+
+DECLARE_GAME_CONTEXT(PopoutContext)
 
 // Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
+#define OFFBOARD -1
+
+static int PieceAt(PopoutContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDCOLSIZE || y >= LIGHTSBOARDROWSIZE)
+		return OFFBOARD;
+
+	return ctx->board[x][y];
+}
 
-static unsigned short InitSetupPhase(unsigned short freshConfiguration)
+static void SetPiece(PopoutContext *ctx, int x, int y, int color)
 {
-	m_bIsSetup = 1;
+	ctx->board[x][y] = (unsigned char)color;
+	FB_IlluminateButton(&ctx->frameBuffer, x, y, color);
+}
+
+
+static unsigned short InitSetupPhase(PopoutContext *ctx, unsigned short freshConfiguration)
+{
+	ctx->bIsSetup = 1;
 
 	if (freshConfiguration) // Do initial setup stuff here that should only happen on fresh reloads.
 	{
 		// Create our "home" configuration.
-		SetBoardSize(LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
-		IlluminateBoard(OFFCOLOR);
+		FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
+		FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
 		SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP);
 	}
@@ -83,9 +112,9 @@ static unsigned short InitSetupPhase(unsigned short freshConfiguration)
 	return 0;
 }
 
-static void InitGamePhase()
+static void InitGamePhase(PopoutContext *ctx)
 {
-	m_bIsSetup = 0;
+	ctx->bIsSetup = 0;
 
 	// Play our start que
 	PlaySoundPreset(SOUNDID_GAMESTART);
@@ -95,10 +124,15 @@ static void InitGamePhase()
 	SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSTART);
 
 	// Create our starting LED configuration.
-	SetBoardSize(LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
-	IlluminateBoard(OFFCOLOR);
+	FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
+	FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
-	turnCount = 0;
+	for (int i = 0; i < LIGHTSBOARDCOLSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDROWSIZE; j++)
+			ctx->board[i][j] = OFFCOLOR;
+	}
+
+	ctx->turnCount = 0;
 
 	// Init our game phase menu.
 	ClearAllMenuOptions();
@@ -106,17 +140,17 @@ static void InitGamePhase()
 	RegisterMenuOption(SPT_OPTIONS_RECONFIGURE, IMAGEID_NONE, MSLOT_G_RECONFIGURE);
 }
 
-static void EndGame(int color) {
+static void EndGame(PopoutContext *ctx, int color) {
 
 	switch (color) {
 	case P1COLOR: SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY); break;
 	case P2COLOR: SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY); break;
 	}
 
-	InitSetupPhase(0);
+	InitSetupPhase(ctx, 0);
 }
 
-static short VictoryCheck(int x, int y, int color, int pop)
+static short VictoryCheck(PopoutContext *ctx, int x, int y, int color, int pop)
 {
 	int combo = 0;
 
@@ -128,14 +162,14 @@ static short VictoryCheck(int x, int y, int color, int pop)
 		for (int i = 0; i < 7; i++) {
 			for (int j = 0; j < 6; j++) {
 
-				if (GetButtonColorAtPos(i, j) == P1COLOR && p1Win == 0) {
-					if (VictoryCheck(i, j, P1COLOR, 0) == 1) {
+				if (PieceAt(ctx, i, j) == P1COLOR && p1Win == 0) {
+					if (VictoryCheck(ctx, i, j, P1COLOR, 0) == 1) {
 						p1Win = 1;
 					}
 				}
 
-				if (GetButtonColorAtPos(i, j) == P2COLOR && p2Win == 0) {
-					if (VictoryCheck(i, j, P2COLOR, 0) == 1) {
+				if (PieceAt(ctx, i, j) == P2COLOR && p2Win == 0) {
+					if (VictoryCheck(ctx, i, j, P2COLOR, 0) == 1) {
 						p2Win = 1;
 					}
 				}
@@ -169,7 +203,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 	int k = 0;
 	for (int i = x; i >= 0; i--) {
 
-		if (GetButtonColorAtPos(i, y) == color && (k < 4)) {
+		if (PieceAt(ctx, i, y) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -187,7 +221,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 	k = 0;
 	for (int i = x; i < 7; i++) {
 
-		if (GetButtonColorAtPos(i, y) == color && (k < 4)) {
+		if (PieceAt(ctx, i, y) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -207,7 +241,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 	k = 0;
 	for (int i = y; i < 6; i++) {
 
-		if (GetButtonColorAtPos(x, i) == color && (k < 4)) {
+		if (PieceAt(ctx, x, i) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -233,7 +267,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j--;
@@ -256,7 +290,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j++;
@@ -282,7 +316,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j++;
@@ -305,7 +339,7 @@ static short VictoryCheck(int x, int y, int color, int pop)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j--;
@@ -321,22 +355,22 @@ static short VictoryCheck(int x, int y, int color, int pop)
 	return 0;
 }
 
-static Popout(int x, int y) {
+static void Popout(PopoutContext *ctx, int x, int y) {
 
 	for (int i = y; i >= 0; i--) {
 
-		if ((GetButtonColorAtPos(x, i - 1) == OFFCOLOR) || i == 0) {
-			IlluminateButton(x, i, OFFCOLOR);
+		if ((PieceAt(ctx, x, i - 1) == OFFCOLOR) || i == 0) {
+			SetPiece(ctx, x, i, OFFCOLOR);
 			break;
 		}
 
-		IlluminateButton(x, i, GetButtonColorAtPos(x, i - 1));
+		SetPiece(ctx, x, i, PieceAt(ctx, x, i - 1));
 	}
 }
 
-static void MakeMove(int x, int y) {
+static void MakeMove(PopoutContext *ctx, int x, int y) {
 
-	int playerTurn = turnCount % 2;
+	int playerTurn = ctx->turnCount % 2;
 	int color, pop = 0;
 
 	switch (playerTurn) {
@@ -345,35 +379,35 @@ static void MakeMove(int x, int y) {
 	}
 
 	//if player color is selected, do a popout
-	if (GetButtonColorAtPos(x, y) == color) {
-		Popout(x, y);
-		turnCount++;
+	if (PieceAt(ctx, x, y) == color) {
+		Popout(ctx, x, y);
+		ctx->turnCount++;
 		pop = 1;
 	}
 
 	//if empty space is selected, do a regular move
-	if (GetButtonColorAtPos(x, y) != P1COLOR && GetButtonColorAtPos(x, y) != P2COLOR && pop == 0) {
+	if (PieceAt(ctx, x, y) != P1COLOR && PieceAt(ctx, x, y) != P2COLOR && pop == 0) {
 
 		for (int i = 5; i >= 0; i--) {
 
-			if ((GetButtonColorAtPos(x, i) == P1COLOR) || (GetButtonColorAtPos(x, i) == P2COLOR))
+			if ((PieceAt(ctx, x, i) == P1COLOR) || (PieceAt(ctx, x, i) == P2COLOR))
 				continue;
 
-			IlluminateButton(x, i, color);
+			SetPiece(ctx, x, i, color);
 			y = i;
-			turnCount++;
+			ctx->turnCount++;
 			break;
 		}
 	}
 
-	if (turnCount > 6) {
+	if (ctx->turnCount > 6) {
 
-		switch (VictoryCheck(x, y, color, pop)) {
+		switch (VictoryCheck(ctx, x, y, color, pop)) {
 		case 0: break;
-		case 1: EndGame(color); break;
-		case 2: EndGame(P1COLOR); break;
-		case 3: EndGame(P2COLOR); break;
-		case 4: EndGame(DRAWCOLOR); break;
+		case 1: EndGame(ctx, color); break;
+		case 2: EndGame(ctx, P1COLOR); break;
+		case 3: EndGame(ctx, P2COLOR); break;
+		case 4: EndGame(ctx, DRAWCOLOR); break;
 		}
 	}
 }
@@ -382,15 +416,23 @@ static void MakeMove(int x, int y) {
 
 GF_PREFIX int GAMEFUNC(OnGameLoaded)()
 {
-	return InitSetupPhase(1);
+	PopoutContext *ctx = GetContext();
+	unsigned short result = InitSetupPhase(ctx, 1);
+
+	FB_Commit(&ctx->frameBuffer);
+	return result;
 }
 
 GF_PREFIX void GAMEFUNC(OnButtonPressed)(int x, int y)
 {
-	if(m_bIsSetup)
+	PopoutContext *ctx = GetContext();
+
+	if(ctx->bIsSetup)
 		PlaySoundPreset(SOUNDID_DENY);
 	else
-		MakeMove(x, y);
+		MakeMove(ctx, x, y);
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnLCDButtonPressed)(int id)
@@ -416,21 +458,25 @@ GF_PREFIX void GAMEFUNC(OnLCDTimerHitZero)(int id)
 
 GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 {
-	if (m_bIsSetup)
+	PopoutContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 	{
 		switch (id)
 		{
-		case MSLOT_S_STARTGAME: InitGamePhase(); break;
+		case MSLOT_S_STARTGAME: InitGamePhase(ctx); break;
 		}
 	}
 	else
 	{
 		switch (id)
 		{
-		case MSLOT_G_RESTART: InitGamePhase(); break;
-		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(0); break;
+		case MSLOT_G_RESTART: InitGamePhase(ctx); break;
+		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(ctx, 0); break;
 		}
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 // Fires when the system has not received an input for a "long time"
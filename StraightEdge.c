@@ -21,6 +21,8 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 //###############################################################
 #pragma once
 #include "StandardGameIncludes.h"
+#include "LEDFrameBuffer.h"
+#include "GameContext.h"
 
 // Ensures that all game functions are unique and won't generate linker errors.
 // Assign a gamecode by changing the text before the ## symbols.  Use format [Three Letters]_
@@ -45,23 +47,50 @@ along with The Player Illuminated Negativity Killer Source Code.  If not, see <h
 #define MSLOT_G_RESTART 0
 #define MSLOT_G_RECONFIGURE 1
 
-// Gameplay Variables
-static unsigned char m_bIsSetup; // 1 if setup phase, 0 if game phase.
-static unsigned char m_iBoardSize;
+// Gameplay Variables.  One set per table, see GameContext.h.
+typedef struct
+{
+	unsigned char bIsSetup; // 1 if setup phase, 0 if game phase.
+	unsigned char iBoardSize;
+
+	int turnCount;
+
+	// Everything we draw goes through here and reaches the LEDs once per callback.
+	LEDFrameBuffer frameBuffer;
 
-static int turnCount = 0;
+	// The board is kept here and the LEDs only ever show it, never get read back.
+	unsigned char board[LIGHTSBOARDCOLSIZE][LIGHTSBOARDROWSIZE]; // piece color in each slot, OFFCOLOR if empty
+} StraightEdgeContext;
+
+DECLARE_GAME_CONTEXT(StraightEdgeContext)
 
 // Game Specific Functions!  ALL OF THESE SHOULD BE DECLARED STATIC TO LIMIT THEM TO THE FILE SCOPE!
+#define OFFBOARD -1
+
+static int PieceAt(StraightEdgeContext *ctx, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= LIGHTSBOARDCOLSIZE || y >= LIGHTSBOARDROWSIZE)
+		return OFFBOARD;
+
+	return ctx->board[x][y];
+}
 
-static unsigned short InitSetupPhase(unsigned short freshConfiguration)
+static void SetPiece(StraightEdgeContext *ctx, int x, int y, int color)
 {
-	m_bIsSetup = 1;
+	ctx->board[x][y] = (unsigned char)color;
+	FB_IlluminateButton(&ctx->frameBuffer, x, y, color);
+}
+
+
+static unsigned short InitSetupPhase(StraightEdgeContext *ctx, unsigned short freshConfiguration)
+{
+	ctx->bIsSetup = 1;
 
 	if (freshConfiguration) // Do initial setup stuff here that should only happen on fresh reloads.
 	{
 		// Create our "home" configuration.
-		SetBoardSize(LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
-		IlluminateBoard(OFFCOLOR);
+		FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
+		FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
 		SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP);
 	}
@@ -82,9 +111,9 @@ static unsigned short InitSetupPhase(unsigned short freshConfiguration)
 	return 0;
 }
 
-static void InitGamePhase()
+static void InitGamePhase(StraightEdgeContext *ctx)
 {
-	m_bIsSetup = 0;
+	ctx->bIsSetup = 0;
 
 	// Play our start que
 	PlaySoundPreset(SOUNDID_GAMESTART);
@@ -94,10 +123,15 @@ static void InitGamePhase()
 	SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSTART);
 
 	// Create our starting LED configuration.
-	SetBoardSize(LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
-	IlluminateBoard(OFFCOLOR);
+	FB_SetBoardSize(&ctx->frameBuffer, LIGHTSBOARDCOLSIZE, LIGHTSBOARDROWSIZE);
+	FB_IlluminateBoard(&ctx->frameBuffer, OFFCOLOR);
 
-	turnCount = 0;
+	for (int i = 0; i < LIGHTSBOARDCOLSIZE; i++) {
+		for (int j = 0; j < LIGHTSBOARDROWSIZE; j++)
+			ctx->board[i][j] = OFFCOLOR;
+	}
+
+	ctx->turnCount = 0;
 
 	// Init our game phase menu.
 	ClearAllMenuOptions();
@@ -105,17 +139,17 @@ static void InitGamePhase()
 	RegisterMenuOption(SPT_OPTIONS_RECONFIGURE, IMAGEID_NONE, MSLOT_G_RECONFIGURE);
 }
 
-static void EndGame(int color) {
+static void EndGame(StraightEdgeContext *ctx, int color) {
 
 	switch (color) {
 	case P1COLOR: SetLCDGameMessage(SPT_GAMEMESSAGE_REDVICTORY); break;
 	case P2COLOR: SetLCDGameMessage(SPT_GAMEMESSAGE_BLUEVICTORY); break;
 	}
 
-	InitSetupPhase(0);
+	InitSetupPhase(ctx, 0);
 }
 
-static short VictoryCheck(int x, int y, int color)
+static short VictoryCheck(StraightEdgeContext *ctx, int x, int y, int color)
 {
 	int combo = 0;
 
@@ -125,7 +159,7 @@ static short VictoryCheck(int x, int y, int color)
 	int k = 0;
 	for (int i = x; i >= 0; i--) {
 
-		if (GetButtonColorAtPos(i, y) == color && (k < 4)) {
+		if (PieceAt(ctx, i, y) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -143,7 +177,7 @@ static short VictoryCheck(int x, int y, int color)
 	k = 0;
 	for (int i = x; i < 7; i++) {
 
-		if (GetButtonColorAtPos(i, y) == color && (k < 4)) {
+		if (PieceAt(ctx, i, y) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -163,7 +197,7 @@ static short VictoryCheck(int x, int y, int color)
 	k = 0;
 	for (int i = y; i < 6; i++) {
 
-		if (GetButtonColorAtPos(x, i) == color && (k < 4)) {
+		if (PieceAt(ctx, x, i) == color && (k < 4)) {
 			combo++;
 			k++;
 			continue;
@@ -189,7 +223,7 @@ static short VictoryCheck(int x, int y, int color)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j--;
@@ -212,7 +246,7 @@ static short VictoryCheck(int x, int y, int color)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j++;
@@ -238,7 +272,7 @@ static short VictoryCheck(int x, int y, int color)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j++;
@@ -261,7 +295,7 @@ static short VictoryCheck(int x, int y, int color)
 			break;
 		}
 
-		if (GetButtonColorAtPos(i, j) == color && (k < 4)) {
+		if (PieceAt(ctx, i, j) == color && (k < 4)) {
 			combo++;
 			k++;
 			j--;
@@ -277,9 +311,9 @@ static short VictoryCheck(int x, int y, int color)
 	return 0;
 }
 
-static void MakeMove(int x, int y) {
+static void MakeMove(StraightEdgeContext *ctx, int x, int y) {
 
-	int playerTurn = turnCount % 2;
+	int playerTurn = ctx->turnCount % 2;
 	int color;
 
 	switch (playerTurn) {
@@ -287,25 +321,25 @@ static void MakeMove(int x, int y) {
 	case 1: color = P2COLOR; break;
 	}
 
-	if (GetButtonColorAtPos(x, y) != P1COLOR && GetButtonColorAtPos(x, y) != P2COLOR) {
+	if (PieceAt(ctx, x, y) != P1COLOR && PieceAt(ctx, x, y) != P2COLOR) {
 		for (int i = 5; i >= 0; i--) {
 
-			if ((GetButtonColorAtPos(x, i) == P1COLOR) || (GetButtonColorAtPos(x, i) == P2COLOR))
+			if ((PieceAt(ctx, x, i) == P1COLOR) || (PieceAt(ctx, x, i) == P2COLOR))
 				continue;
 
-			IlluminateButton(x, i, color);
+			SetPiece(ctx, x, i, color);
 			y = i;
-			turnCount++;
+			ctx->turnCount++;
 			break;
 		}
 	}
 
-	if (turnCount > 6) {
-		if (VictoryCheck(x, y, color) == 1)
-			EndGame(color);
-		else if (turnCount == 42) {
+	if (ctx->turnCount > 6) {
+		if (VictoryCheck(ctx, x, y, color) == 1)
+			EndGame(ctx, color);
+		else if (ctx->turnCount == 42) {
 			SetLCDGameMessage(SPT_GAMEMESSAGE_TIEGAME);
-			InitSetupPhase(0);
+			InitSetupPhase(ctx, 0);
 		}
 	}
 
@@ -315,15 +349,23 @@ static void MakeMove(int x, int y) {
 
 GF_PREFIX int GAMEFUNC(OnGameLoaded)()
 {
-	return InitSetupPhase(1);
+	StraightEdgeContext *ctx = GetContext();
+	unsigned short result = InitSetupPhase(ctx, 1);
+
+	FB_Commit(&ctx->frameBuffer);
+	return result;
 }
 
 GF_PREFIX void GAMEFUNC(OnButtonPressed)(int x, int y)
 {
-	if (m_bIsSetup)
+	StraightEdgeContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 		PlaySoundPreset(SOUNDID_DENY);
 	else
-		MakeMove(x, y);
+		MakeMove(ctx, x, y);
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 GF_PREFIX void GAMEFUNC(OnLCDButtonPressed)(int id)
@@ -349,21 +391,25 @@ GF_PREFIX void GAMEFUNC(OnLCDTimerHitZero)(int id)
 
 GF_PREFIX void GAMEFUNC(OnMenuOptionSelected)(int id)
 {
-	if (m_bIsSetup)
+	StraightEdgeContext *ctx = GetContext();
+
+	if (ctx->bIsSetup)
 	{
 		switch (id)
 		{
-		case MSLOT_S_STARTGAME: InitGamePhase(); break;
+		case MSLOT_S_STARTGAME: InitGamePhase(ctx); break;
 		}
 	}
 	else
 	{
 		switch (id)
 		{
-		case MSLOT_G_RESTART: InitGamePhase(); break;
-		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(0); break;
+		case MSLOT_G_RESTART: InitGamePhase(ctx); break;
+		case MSLOT_G_RECONFIGURE: SetLCDGameMessage(SPT_GAMEMESSAGE_GENERICSETUP); InitSetupPhase(ctx, 0); break;
 		}
 	}
+
+	FB_Commit(&ctx->frameBuffer);
 }
 
 // Fires when the system has not received an input for a "long time"
@@ -0,0 +1,168 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CallbackStats.c
+//# Per game, per callback latency and hardware call accounting.
+//###############################################################
+#include "CallbackStats.h"
+
+#include <string.h>
+#include <time.h>
+
+static const char *m_callbackNames[EV_COUNT] = {
+	"OnGameLoaded", "OnButtonPressed", "OnLCDButtonPressed", "OnMenuOptionSelected",
+	"OnLCDTimerHitZero", "OnTimerFinished", "OnIdle", "OnWake", "OnExit"
+};
+
+static const char *m_hwNames[HW_COUNT] = {
+	"GetButtonColorAtPos", "IlluminateButton", "IlluminateBoard", "SetLCDScoreDisplayValue", "other LCD", "menu"
+};
+
+static unsigned long long NowNanos()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Values under 8 get their own bucket, above that each power of two is split in four.
+static int BucketOf(unsigned long long nanos)
+{
+	int bucket, exponent;
+
+	if (nanos < 8)
+		return (int)nanos;
+
+	exponent = 63 - __builtin_clzll(nanos);
+	bucket = (exponent - 1) * 4 + (int)((nanos >> (exponent - 2)) & 3);
+
+	return bucket < STATS_BUCKETS ? bucket : STATS_BUCKETS - 1;
+}
+
+static unsigned long long BucketUpperBound(int bucket)
+{
+	int exponent;
+
+	if (bucket < 8)
+		return bucket;
+
+	exponent = bucket / 4 + 1;
+	return ((unsigned long long)(4 + bucket % 4) << (exponent - 2)) + (1ULL << (exponent - 2)) - 1;
+}
+
+void Stats_Begin(StatsProbe *probe, const unsigned long *hwCalls)
+{
+	memcpy(probe->hwStart, hwCalls, sizeof(probe->hwStart));
+	probe->startNanos = NowNanos();
+}
+
+void Stats_End(StatsSet *set, StatsProbe *probe, int gameID, int callback, const unsigned long *hwCalls)
+{
+	unsigned long long elapsed = NowNanos() - probe->startNanos;
+	CallbackStats *stats;
+
+	if (gameID < 0 || gameID >= MAX_GAMES || callback < 0 || callback >= EV_COUNT)
+		return;
+
+	stats = &set->callbacks[gameID][callback];
+	stats->calls++;
+	stats->totalNanos += elapsed;
+	if (elapsed > stats->maxNanos)
+		stats->maxNanos = elapsed;
+	stats->buckets[BucketOf(elapsed)]++;
+
+	for (int i = 0; i < HW_COUNT; i++) {
+		unsigned long made = hwCalls[i] - probe->hwStart[i];
+
+		stats->hwCalls[i] += made;
+		if (made > stats->hwMax[i])
+			stats->hwMax[i] = made;
+	}
+}
+
+void Stats_Merge(StatsSet *into, const StatsSet *from)
+{
+	for (int game = 0; game < MAX_GAMES; game++) {
+		for (int cb = 0; cb < EV_COUNT; cb++) {
+			CallbackStats *to = &into->callbacks[game][cb];
+			const CallbackStats *add = &from->callbacks[game][cb];
+
+			to->calls += add->calls;
+			to->totalNanos += add->totalNanos;
+			if (add->maxNanos > to->maxNanos)
+				to->maxNanos = add->maxNanos;
+			for (int i = 0; i < STATS_BUCKETS; i++)
+				to->buckets[i] += add->buckets[i];
+			for (int i = 0; i < HW_COUNT; i++) {
+				to->hwCalls[i] += add->hwCalls[i];
+				if (add->hwMax[i] > to->hwMax[i])
+					to->hwMax[i] = add->hwMax[i];
+			}
+		}
+	}
+}
+
+unsigned long long Stats_Percentile(const CallbackStats *stats, double fraction)
+{
+	unsigned long long target = (unsigned long long)(stats->calls * fraction);
+	unsigned long long seen = 0;
+
+	if (stats->calls == 0)
+		return 0;
+
+	for (int i = 0; i < STATS_BUCKETS; i++) {
+		seen += stats->buckets[i];
+		if (seen > target) {
+			unsigned long long bound = BucketUpperBound(i);
+			return bound < stats->maxNanos ? bound : stats->maxNanos;
+		}
+	}
+
+	return stats->maxNanos;
+}
+
+void Stats_Print(FILE *out, const StatsSet *set, const char *const *gameNames, int gameNameCount)
+{
+	fprintf(out, "%-16s %-20s %10s %9s %9s %9s %9s\n", "game", "callback", "calls", "mean ns", "p50 ns", "p99 ns", "max ns");
+
+	for (int game = 0; game < MAX_GAMES; game++) {
+		for (int cb = 0; cb < EV_COUNT; cb++) {
+			const CallbackStats *stats = &set->callbacks[game][cb];
+			char name[16];
+
+			if (stats->calls == 0)
+				continue;
+
+			if (gameNames && game < gameNameCount)
+				snprintf(name, sizeof(name), "%s", gameNames[game]);
+			else
+				snprintf(name, sizeof(name), "game %d", game);
+
+			fprintf(out, "%-16s %-20s %10llu %9llu %9llu %9llu %9llu\n", name, m_callbackNames[cb], stats->calls,
+				stats->totalNanos / stats->calls, Stats_Percentile(stats, 0.50), Stats_Percentile(stats, 0.99), stats->maxNanos);
+
+			// Hardware calls per callback, as mean / worst single call.
+			for (int hw = 0; hw < HW_COUNT; hw++) {
+				if (stats->hwCalls[hw] == 0)
+					continue;
+				fprintf(out, "%37s %-24s %9.2f avg %6lu max\n", "", m_hwNames[hw], (double)stats->hwCalls[hw] / stats->calls, stats->hwMax[hw]);
+			}
+		}
+	}
+}
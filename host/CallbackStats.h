@@ -0,0 +1,66 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CallbackStats.h
+//# Wall-time histograms and hardware call counts for every
+//# game callback the simulator delivers.
+//###############################################################
+#pragma once
+#include "HostSimulator.h"
+
+#include <stdio.h>
+
+// Log-linear histogram: 4 buckets per power of two, good to about 20%.
+#define STATS_BUCKETS 192
+
+typedef struct
+{
+	unsigned long long calls;
+	unsigned long long totalNanos;
+	unsigned long long maxNanos;
+	unsigned long long buckets[STATS_BUCKETS];
+
+	unsigned long long hwCalls[HW_COUNT]; // summed over all calls
+	unsigned long hwMax[HW_COUNT];        // most made by a single call
+} CallbackStats;
+
+// Every game/callback pair for one table.
+typedef struct StatsSet
+{
+	CallbackStats callbacks[MAX_GAMES][EV_COUNT];
+} StatsSet;
+
+// Snapshot taken when a callback starts.
+typedef struct
+{
+	unsigned long long startNanos;
+	unsigned long hwStart[HW_COUNT];
+} StatsProbe;
+
+void Stats_Begin(StatsProbe *probe, const unsigned long *hwCalls);
+void Stats_End(StatsSet *set, StatsProbe *probe, int gameID, int callback, const unsigned long *hwCalls);
+
+// Adds everything in from into into, e.g. to total up several tables.
+void Stats_Merge(StatsSet *into, const StatsSet *from);
+
+// Nanoseconds below which fraction (0 to 1) of the calls finished.
+unsigned long long Stats_Percentile(const CallbackStats *stats, double fraction);
+
+// One line per game/callback pair that has been called.  gameNames may be 0.
+void Stats_Print(FILE *out, const StatsSet *set, const char *const *gameNames, int gameNameCount);
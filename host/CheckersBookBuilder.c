@@ -0,0 +1,294 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersBookBuilder.c
+//# Collects every (position, reply) pair seen, then sorts and
+//# merges them into the book file.
+//###############################################################
+#include "CheckersBookBuilder.h"
+#include "CheckersBook.h"
+#include "CheckersSearch.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADERSIZE 16
+#define ENTRYSIZE 16
+#define SELFPLAY_NODES 5000 // search per candidate move
+#define SELFPLAY_MARGIN 20  // how far below the best a move may score and still be played
+#define SELFPLAY_TTENTRIES (1 << 16)
+#define MAXWEIGHT 65535
+
+typedef struct
+{
+	unsigned long long key;
+	unsigned int captured;
+	unsigned char from, to;
+	unsigned long weight;
+} BookEntry;
+
+typedef struct
+{
+	BookEntry *entries;
+	unsigned long count, capacity;
+} BookEntries;
+
+static unsigned int NextRandom(unsigned int *state)
+{
+	*state = *state * 1103515245u + 12345u;
+	return *state >> 8;
+}
+
+static int AddEntry(BookEntries *book, const CheckersPosition *pos, const CheckersMove *move)
+{
+	BookEntry *entry;
+
+	if (book->count == book->capacity) {
+		unsigned long capacity = book->capacity ? book->capacity * 2 : 1024;
+		BookEntry *entries = (BookEntry *)realloc(book->entries, capacity * sizeof(BookEntry));
+
+		if (!entries)
+			return -1;
+		book->entries = entries;
+		book->capacity = capacity;
+	}
+
+	entry = &book->entries[book->count++];
+	entry->key = pos->hash;
+	entry->captured = move->captured;
+	entry->from = move->from;
+	entry->to = move->to;
+	entry->weight = 1;
+	return 0;
+}
+
+static int CompareEntries(const void *a, const void *b)
+{
+	const BookEntry *x = (const BookEntry *)a, *y = (const BookEntry *)b;
+
+	if (x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	if (x->from != y->from)
+		return x->from - y->from;
+	if (x->to != y->to)
+		return x->to - y->to;
+	if (x->captured != y->captured)
+		return x->captured < y->captured ? -1 : 1;
+	return 0;
+}
+
+static int SelfPlay(BookEntries *book, int plies, unsigned int *random, CheckersTT *tt)
+{
+	CheckersPosition pos;
+
+	CK_SetStartPosition(&pos);
+	for (int ply = 0; ply < plies; ply++) {
+		CheckersMoveList list;
+		int scores[CK_MAXMOVES], best = -CK_INFINITY, candidates = 0, pick;
+
+		if (CK_GenerateMoves(&pos, &list) == 0)
+			break;
+
+		for (int i = 0; i < list.count; i++) {
+			CheckersSearchLimits limits;
+			CheckersSearchResult result;
+			CheckersPosition next = pos;
+
+			memset(&limits, 0, sizeof(limits));
+			limits.maxNodes = SELFPLAY_NODES;
+			limits.tt = tt;
+			CK_MakeMove(&next, &list.moves[i]);
+			scores[i] = CK_Search(&next, &limits, &result) ? -result.score : CK_WIN;
+			if (scores[i] > best)
+				best = scores[i];
+		}
+
+		for (int i = 0; i < list.count; i++) {
+			if (scores[i] >= best - SELFPLAY_MARGIN)
+				candidates++;
+		}
+		pick = (int)(NextRandom(random) % candidates);
+		for (int i = 0; i < list.count; i++) {
+			if (scores[i] >= best - SELFPLAY_MARGIN && pick-- == 0) {
+				if (AddEntry(book, &pos, &list.moves[i]) != 0)
+					return -1;
+				CK_MakeMove(&pos, &list.moves[i]);
+				break;
+			}
+		}
+	}
+	return 0;
+}
+
+// Finds the legal move a record's token stands for: from-to for a step, from x landing x ... for a capture.
+static const CheckersMove *ParseMove(const CheckersMoveList *list, const char *token)
+{
+	int squares[CK_MAXHOPS + 1], count = 0;
+
+	while (*token && count <= CK_MAXHOPS) {
+		if (!isdigit((unsigned char)*token))
+			return 0;
+		squares[count++] = (int)strtol(token, (char **)&token, 10) - 1;
+		if (*token == '-' || *token == 'x')
+			token++;
+		else if (*token)
+			return 0;
+	}
+	if (count < 2)
+		return 0;
+
+	for (int i = 0; i < list->count; i++) {
+		const CheckersMove *move = &list->moves[i];
+		int bMatch = move->from == squares[0] && move->to == squares[count - 1];
+
+		// Landing squares only need to be given where they tell two captures apart.
+		if (bMatch && count > 2) {
+			if (count != move->hops + 1)
+				continue;
+			for (int j = 1; j < count - 1; j++)
+				bMatch &= move->path[j] == squares[j];
+		}
+		if (bMatch)
+			return move;
+	}
+	return 0;
+}
+
+static int ReadRecords(BookEntries *book, int plies, const char *path, int *games)
+{
+	char line[4096];
+	FILE *in = fopen(path, "r");
+
+	if (!in)
+		return -1;
+
+	while (fgets(line, sizeof(line), in)) {
+		CheckersPosition pos;
+		int ply = 0;
+
+		if (line[0] == '[')
+			continue;
+
+		CK_SetStartPosition(&pos);
+		for (char *token = strtok(line, " \t\r\n"); token && ply < plies; token = strtok(0, " \t\r\n")) {
+			CheckersMoveList list;
+			const CheckersMove *move;
+
+			if (token[strlen(token) - 1] == '.')
+				continue;
+			CK_GenerateMoves(&pos, &list);
+			move = ParseMove(&list, token);
+			if (!move)
+				break;
+			if (AddEntry(book, &pos, move) != 0) {
+				fclose(in);
+				return -1;
+			}
+			CK_MakeMove(&pos, move);
+			ply++;
+		}
+		if (ply > 0)
+			(*games)++;
+	}
+
+	fclose(in);
+	return 0;
+}
+
+static void PutWord(unsigned char *p, unsigned long long value, int bytes)
+{
+	for (int i = 0; i < bytes; i++, value >>= 8)
+		p[i] = (unsigned char)value;
+}
+
+static int WriteBook(BookEntries *book, const char *path)
+{
+	unsigned char header[HEADERSIZE] = { 'P', 'C', 'B', 'K', CK_BOOK_VERSION };
+	unsigned long count = 0, positions = 0;
+	FILE *out;
+
+	// Sorted, duplicates become weight.
+	qsort(book->entries, book->count, sizeof(BookEntry), CompareEntries);
+	for (unsigned long i = 0; i < book->count; i++) {
+		if (count > 0 && CompareEntries(&book->entries[count - 1], &book->entries[i]) == 0)
+			book->entries[count - 1].weight += book->entries[i].weight;
+		else {
+			if (count == 0 || book->entries[count - 1].key != book->entries[i].key)
+				positions++;
+			book->entries[count++] = book->entries[i];
+		}
+	}
+
+	out = fopen(path, "wb");
+	if (!out)
+		return -1;
+	PutWord(header + 8, count, 4);
+	fwrite(header, 1, HEADERSIZE, out);
+	for (unsigned long i = 0; i < count; i++) {
+		unsigned char entry[ENTRYSIZE];
+
+		PutWord(entry, book->entries[i].key, 8);
+		PutWord(entry + 8, book->entries[i].captured, 4);
+		entry[12] = book->entries[i].from;
+		entry[13] = book->entries[i].to;
+		PutWord(entry + 14, book->entries[i].weight < MAXWEIGHT ? book->entries[i].weight : MAXWEIGHT, 2);
+		fwrite(entry, 1, ENTRYSIZE, out);
+	}
+	if (fclose(out) != 0)
+		return -1;
+
+	printf("wrote %lu replies to %lu positions to %s\n", count, positions, path);
+	return 0;
+}
+
+int Book_Build(const char *path, int selfPlayGames, int plies, const char *recordPath, unsigned int seed)
+{
+	BookEntries book = { 0, 0, 0 };
+	CheckersTTEntry *ttEntries = (CheckersTTEntry *)malloc(SELFPLAY_TTENTRIES * sizeof(CheckersTTEntry));
+	CheckersTT tt;
+	unsigned int random = seed;
+	int games = 0, result = 0;
+
+	if (!ttEntries) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	CK_InitTT(&tt, ttEntries, SELFPLAY_TTENTRIES);
+
+	for (int i = 0; i < selfPlayGames && result == 0; i++)
+		result = SelfPlay(&book, plies, &random, &tt);
+	if (result == 0 && recordPath) {
+		result = ReadRecords(&book, plies, recordPath, &games);
+		if (result != 0)
+			fprintf(stderr, "can't read %s\n", recordPath);
+		else
+			printf("read %d games from %s\n", games, recordPath);
+	}
+	if (result == 0) {
+		result = WriteBook(&book, path);
+		if (result != 0)
+			fprintf(stderr, "can't write %s\n", path);
+	}
+
+	free(book.entries);
+	free(ttEntries);
+	return result == 0 ? 0 : 1;
+}
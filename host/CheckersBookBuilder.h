@@ -0,0 +1,35 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersBookBuilder.h
+//# Builds a Checkers opening book in the CheckersBook.h format,
+//# from self-play and from game records.
+//###############################################################
+#pragma once
+
+// Game records are one game to a line, as moves in CheckersPerft.h square numbers:
+//   22-17 9-14 17x10 6x15 ...
+// Move numbers ("1.") are skipped, as are lines starting with '[', and a game's
+// record stops at anything that isn't a legal move, such as a result.
+
+// Records the first plies moves of selfPlayGames games the computer plays against
+// itself, varying its choice among the moves that score close to the best, and of
+// every game in recordPath if it isn't 0.  Each time a move is played in a position
+// adds one to its weight.  Returns 0 on success.
+int Book_Build(const char *path, int selfPlayGames, int plies, const char *recordPath, unsigned int seed);
@@ -0,0 +1,222 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersPerft.c
+//# Perft driver for CheckersEngine.
+//###############################################################
+#include "CheckersPerft.h"
+#include "DraughtsEngine.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double NowSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int Perft_ParsePosition(CheckersPosition *pos, const char *text)
+{
+	int side = -1;
+
+	CK_Clear(pos);
+
+	if (*text == 'R')
+		CK_SetSide(pos, 0);
+	else if (*text == 'B')
+		CK_SetSide(pos, 1);
+	else
+		return -1;
+	text++;
+
+	while (*text) {
+		int king = 0;
+		long square;
+		char *end;
+
+		if (*text == ':') {
+			text++;
+			if (*text == 'R')
+				side = 0;
+			else if (*text == 'B')
+				side = 1;
+			else
+				return -1;
+			text++;
+			continue;
+		}
+		if (*text == ',' || isspace((unsigned char)*text)) {
+			text++;
+			continue;
+		}
+		if (side < 0)
+			return -1;
+
+		if (*text == 'K') {
+			king = 1;
+			text++;
+		}
+		if (!isdigit((unsigned char)*text))
+			return -1;
+
+		square = strtol(text, &end, 10);
+		if (square < 1 || square > CK_SQUARES)
+			return -1;
+
+		CK_PutPiece(pos, (int)square - 1, side, king);
+		text = end;
+	}
+
+	return 0;
+}
+
+int Perft_CreateTable(PerftTable *table, int hashMB)
+{
+	unsigned long count = 1;
+
+	memset(table, 0, sizeof(*table));
+	if (hashMB <= 0)
+		return 0;
+
+	// Largest power of two that fits.
+	while (count * 2 * sizeof(PerftEntry) <= (unsigned long)hashMB << 20)
+		count *= 2;
+
+	table->entries = (PerftEntry *)calloc(count, sizeof(PerftEntry));
+	if (!table->entries)
+		return -1;
+
+	table->mask = count - 1;
+	return 0;
+}
+
+void Perft_DestroyTable(PerftTable *table)
+{
+	free(table->entries);
+	memset(table, 0, sizeof(*table));
+}
+
+static PerftEntry *Slot(PerftTable *table, const CheckersPosition *pos, int depth)
+{
+	return &table->entries[(pos->hash ^ depth * 0x9E3779B97F4A7C15ull) & table->mask];
+}
+
+unsigned long long Perft_Count(const CheckersPosition *pos, int depth, PerftTable *table)
+{
+	CheckersMoveList list;
+	PerftEntry *entry = 0;
+	unsigned long long nodes = 0;
+
+	if (depth == 0)
+		return 1;
+
+	// Bulk count: every move at the last ply is one leaf.
+	if (depth == 1)
+		return CK_GenerateMoves(pos, &list);
+
+	if (table->entries) {
+		entry = Slot(table, pos, depth);
+		if (entry->depth == depth && entry->side == pos->side && entry->kings == pos->kings &&
+			entry->pieces[0] == pos->pieces[0] && entry->pieces[1] == pos->pieces[1]) {
+			table->hits++;
+			return entry->nodes;
+		}
+	}
+
+	CK_GenerateMoves(pos, &list);
+	for (int i = 0; i < list.count; i++) {
+		CheckersPosition next = *pos;
+
+		CK_MakeMove(&next, &list.moves[i]);
+		nodes += Perft_Count(&next, depth - 1, table);
+	}
+
+	if (entry) {
+		entry->pieces[0] = pos->pieces[0];
+		entry->pieces[1] = pos->pieces[1];
+		entry->kings = pos->kings;
+		entry->side = (unsigned char)pos->side;
+		entry->depth = (unsigned char)depth;
+		entry->nodes = nodes;
+	}
+
+	return nodes;
+}
+
+int Perft_Run(int maxDepth, int hashMB, const char *position)
+{
+	CheckersPosition pos;
+	PerftTable table;
+
+	if (position) {
+		if (Perft_ParsePosition(&pos, position) != 0) {
+			fprintf(stderr, "can't read position %s\n", position);
+			return 1;
+		}
+	}
+	else
+		CK_SetStartPosition(&pos);
+
+	if (Perft_CreateTable(&table, hashMB) != 0) {
+		fprintf(stderr, "can't allocate %d MB of hash\n", hashMB);
+		return 1;
+	}
+
+	for (int depth = 1; depth <= maxDepth; depth++) {
+		double start = NowSeconds(), elapsed;
+		unsigned long long nodes;
+
+		table.hits = 0;
+		nodes = Perft_Count(&pos, depth, &table);
+		elapsed = NowSeconds() - start;
+
+		printf("perft %2d %16llu nodes %9.3f s %14.0f nodes/s %12llu hash hits\n",
+			depth, nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0.0, table.hits);
+	}
+
+	Perft_DestroyTable(&table);
+	return 0;
+}
+
+int Perft_RunVariant(const char *variant, int maxDepth)
+{
+	const DraughtsVariant *rules = DV_FindVariant(variant);
+	DraughtsPosition pos;
+
+	if (!rules) {
+		fprintf(stderr, "unknown variant %s\n", variant);
+		return 1;
+	}
+	rules->setStartPosition(&pos);
+
+	for (int depth = 1; depth <= maxDepth; depth++) {
+		double start = NowSeconds(), elapsed;
+		unsigned long long nodes = rules->perft(&pos, depth);
+
+		elapsed = NowSeconds() - start;
+		printf("%s perft %2d %16llu nodes %9.3f s %14.0f nodes/s\n",
+			rules->name, depth, nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0.0);
+	}
+	return 0;
+}
@@ -0,0 +1,63 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersPerft.h
+//# Counts the leaf nodes of the Checkers move tree to a fixed
+//# depth, to check the move generator and to time it.
+//#
+//# Positions are written like PDN FEN, with R for player 1
+//# (red, moves first) and B for player 2 (blue).  Squares are
+//# numbered 1-32 from row 0, four to a row, and K marks a king:
+//#   R:R21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12
+//###############################################################
+#pragma once
+#include "CheckersEngine.h"
+
+typedef struct
+{
+	unsigned int pieces[CK_SIDES];
+	unsigned int kings;
+	unsigned char side;
+	unsigned char depth; // 0 marks an empty slot
+	unsigned long long nodes;
+} PerftEntry;
+
+// Transposition table, always-replace.  A table with no entries just counts.
+typedef struct
+{
+	PerftEntry *entries;
+	unsigned long mask;
+	unsigned long long hits;
+} PerftTable;
+
+// Returns 0 on success, -1 if the text isn't a position.
+int Perft_ParsePosition(CheckersPosition *pos, const char *text);
+
+// hashMB of 0 leaves the table empty.  Returns -1 if it can't be allocated.
+int Perft_CreateTable(PerftTable *table, int hashMB);
+void Perft_DestroyTable(PerftTable *table);
+
+// Leaf nodes depth plies below pos.  The last ply is counted straight from the move list.
+unsigned long long Perft_Count(const CheckersPosition *pos, int depth, PerftTable *table);
+
+// Prints the count and speed for every depth from 1 to maxDepth.  position 0 means the start position.
+int Perft_Run(int maxDepth, int hashMB, const char *position);
+
+// The same from the start position of one of the DraughtsEngine variants, by name.
+int Perft_RunVariant(const char *variant, int maxDepth);
@@ -0,0 +1,340 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersTBGen.c
+//# Slices are solved smallest first, so any capture or crowning
+//# leads into a slice that's already finished.  Within a slice
+//# positions are settled by how many plies they are from the
+//# end, and each one settled is stepped backwards to update the
+//# positions that lead to it: a win if some move reaches a
+//# loss, a loss once every move reaches a win.  Whatever is
+//# never settled is a draw.
+//###############################################################
+#include "CheckersTBGen.h"
+#include "CheckersTablebase.h"
+#include "CheckersPerft.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADERSIZE 16
+#define ENTRYSIZE 16
+#define MAXDISTANCE 254 // the longest distance a position byte can hold
+#define MAXSLICES 256   // enough for CK_TB_MAXPIECES
+#define NOTARGET 255
+
+typedef struct
+{
+	int counts[4]; // red men, red kings, blue men, blue kings
+	unsigned long offset;
+	unsigned long size;
+} Slice;
+
+// Per position working state while a slice is solved.
+typedef struct
+{
+	unsigned char *values;      // the slice's bytes in the file
+	unsigned char *targets;     // distance it will be settled at, NOTARGET if not known yet
+	unsigned char *remaining;   // moves inside the slice not settled yet
+	unsigned char *longestWins; // longest win for the opponent among the settled moves
+	unsigned char *bBlocked;    // some move reaches a draw, or the index isn't a position
+} SolveState;
+
+static double NowSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void PutWord(unsigned char *p, unsigned long value, int bytes)
+{
+	for (int i = 0; i < bytes; i++, value >>= 8)
+		p[i] = (unsigned char)value;
+}
+
+// Every set of piece counts with at least one piece a side, in the order they have to be solved.
+static int ListSlices(Slice *slices, int maxPieces)
+{
+	int count = 0;
+
+	for (int total = 2; total <= maxPieces; total++) {
+		for (int men = 0; men <= total; men++) {
+			for (int redMen = 0; redMen <= men; redMen++) {
+				for (int redKings = 0; redKings <= total - men; redKings++) {
+					Slice *slice = &slices[count];
+
+					slice->counts[0] = redMen;
+					slice->counts[1] = redKings;
+					slice->counts[2] = men - redMen;
+					slice->counts[3] = total - men - redKings;
+					if (slice->counts[0] + slice->counts[1] == 0 || slice->counts[2] + slice->counts[3] == 0)
+						continue;
+					slice->size = CK_TablebaseSliceSize(slice->counts[0], slice->counts[1], slice->counts[2], slice->counts[3]);
+					count++;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+static int InSlice(const Slice *slice, const CheckersPosition *pos)
+{
+	return CK_Count(pos->pieces[0] & ~pos->kings) == slice->counts[0] && CK_Count(pos->pieces[0] & pos->kings) == slice->counts[1] &&
+		CK_Count(pos->pieces[1] & ~pos->kings) == slice->counts[2] && CK_Count(pos->pieces[1] & pos->kings) == slice->counts[3];
+}
+
+// Settles a position the given number of plies from the end, then tells every
+// position in the slice that could have led to it with a plain step.
+static void Settle(const Slice *slice, SolveState *state, unsigned long index, int distance)
+{
+	CheckersPosition pos;
+	int mover;
+
+	state->values[index] = (unsigned char)(distance + 1);
+	CK_TablebasePosition(index, slice->counts[0], slice->counts[1], slice->counts[2], slice->counts[3], &pos);
+	mover = pos.side ^ 1;
+
+	for (unsigned int pieces = pos.pieces[mover]; pieces; pieces &= pieces - 1) {
+		int to = CK_Lowest(pieces), king = (pos.kings >> to) & 1;
+
+		for (int dir = 0; dir < 4; dir++) {
+			int dx = (dir & 1) ? 1 : -1, dy = (dir & 2) ? 1 : -1;
+			int from = CK_Square(CK_SquareX(to) - dx, CK_SquareY(to) - dy);
+			CheckersPosition previous = pos;
+			unsigned long before;
+
+			// Red men move towards row 0, blue men towards row 7.
+			if (from < 0 || ((pos.pieces[0] | pos.pieces[1]) & (1u << from)) || (!king && dy != (mover ? 1 : -1)))
+				continue;
+			CK_RemovePiece(&previous, to);
+			CK_PutPiece(&previous, from, mover, king);
+			CK_SetSide(&previous, mover);
+			// A step is only legal when there's nothing to jump.
+			if (CK_Jumpers(&previous))
+				continue;
+
+			before = CK_TablebaseIndex(&previous);
+			if (state->values[before] != CK_TB_DRAW)
+				continue;
+			if (!(distance & 1)) {
+				// Stepping into a loss for the opponent wins.
+				if (distance + 1 < state->targets[before])
+					state->targets[before] = (unsigned char)(distance + 1);
+			}
+			else {
+				if (distance > state->longestWins[before])
+					state->longestWins[before] = (unsigned char)distance;
+				if (--state->remaining[before] == 0 && !state->bBlocked[before] && state->targets[before] == NOTARGET)
+					state->targets[before] = (unsigned char)(state->longestWins[before] + 1);
+			}
+		}
+	}
+}
+
+static int SolveSlice(const CheckersTablebase *tb, const Slice *slice, unsigned char *values)
+{
+	SolveState state;
+	unsigned long counts[3] = { 0, 0, 0 };
+	double start = NowSeconds();
+	int sliceLongest = 0;
+
+	state.values = values;
+	state.targets = (unsigned char *)malloc(slice->size);
+	state.remaining = (unsigned char *)calloc(slice->size, 1);
+	state.longestWins = (unsigned char *)calloc(slice->size, 1);
+	state.bBlocked = (unsigned char *)calloc(slice->size, 1);
+	if (!state.targets || !state.remaining || !state.longestWins || !state.bBlocked) {
+		free(state.targets);
+		free(state.remaining);
+		free(state.longestWins);
+		free(state.bBlocked);
+		return -1;
+	}
+	memset(state.targets, NOTARGET, slice->size);
+
+	// Everything that leaves the slice is known already, so look at every move once
+	// and count how many stay inside it.
+	for (unsigned long index = 0; index < slice->size; index++) {
+		CheckersPosition pos;
+		CheckersMoveList list;
+		int shortestLoss = NOTARGET;
+
+		if (!CK_TablebasePosition(index, slice->counts[0], slice->counts[1], slice->counts[2], slice->counts[3], &pos)) {
+			state.bBlocked[index] = 1;
+			continue;
+		}
+
+		CK_GenerateMoves(&pos, &list);
+		if (list.count == 0) {
+			state.targets[index] = 0;
+			continue;
+		}
+		for (int i = 0; i < list.count; i++) {
+			CheckersPosition next = pos;
+			int result, plies;
+
+			CK_MakeMove(&next, &list.moves[i]);
+			if (InSlice(slice, &next)) {
+				state.remaining[index]++;
+				continue;
+			}
+			result = CK_ProbeTablebase(tb, &next, &plies);
+			if (result == CK_TB_LOSS) {
+				if (plies < shortestLoss)
+					shortestLoss = plies;
+			}
+			else if (result == CK_TB_WIN) {
+				if (plies > state.longestWins[index])
+					state.longestWins[index] = (unsigned char)plies;
+			}
+			else
+				state.bBlocked[index] = 1;
+		}
+		if (shortestLoss < MAXDISTANCE)
+			state.targets[index] = (unsigned char)(shortestLoss + 1);
+		else if (state.remaining[index] == 0 && !state.bBlocked[index] && state.longestWins[index] < MAXDISTANCE)
+			state.targets[index] = (unsigned char)(state.longestWins[index] + 1);
+	}
+
+	// Settling a position only ever gives others a longer distance, so going
+	// through the distances in order settles everything at its shortest win
+	// and longest loss.  Targets beyond MAXDISTANCE are left as draws.
+	for (int distance = 0; distance <= MAXDISTANCE; distance++) {
+		for (unsigned long index = 0; index < slice->size; index++) {
+			if (state.targets[index] == distance && values[index] == CK_TB_DRAW)
+				Settle(slice, &state, index, distance);
+		}
+	}
+
+	for (unsigned long index = 0; index < slice->size; index++) {
+		CheckersPosition pos;
+
+		if (values[index] != CK_TB_DRAW) {
+			counts[(values[index] - 1) & 1]++;
+			if (values[index] - 1 > sliceLongest)
+				sliceLongest = values[index] - 1;
+		}
+		else if (CK_TablebasePosition(index, slice->counts[0], slice->counts[1], slice->counts[2], slice->counts[3], &pos))
+			counts[2]++;
+	}
+
+	printf("red %d men %d kings, blue %d men %d kings: %10lu wins %10lu losses %10lu draws, longest %3d plies, %.2f s\n",
+		slice->counts[0], slice->counts[1], slice->counts[2], slice->counts[3],
+		counts[1], counts[0], counts[2], sliceLongest, NowSeconds() - start);
+
+	free(state.targets);
+	free(state.remaining);
+	free(state.longestWins);
+	free(state.bBlocked);
+	return 0;
+}
+
+int TBGen_Generate(const char *path, int maxPieces)
+{
+	Slice slices[MAXSLICES];
+	CheckersTablebase tb;
+	unsigned char *file;
+	unsigned long size;
+	int sliceCount;
+	FILE *out;
+
+	if (maxPieces < 2 || maxPieces > CK_TB_MAXPIECES) {
+		fprintf(stderr, "tables can have 2 to %d pieces\n", CK_TB_MAXPIECES);
+		return 1;
+	}
+
+	sliceCount = ListSlices(slices, maxPieces);
+	size = HEADERSIZE + sliceCount * ENTRYSIZE;
+	for (int i = 0; i < sliceCount; i++) {
+		slices[i].offset = size;
+		size += slices[i].size;
+	}
+
+	file = (unsigned char *)calloc(size, 1);
+	if (!file) {
+		fprintf(stderr, "can't allocate %lu bytes\n", size);
+		return 1;
+	}
+
+	memcpy(file, "PCTB", 4);
+	file[4] = CK_TB_VERSION;
+	file[5] = (unsigned char)maxPieces;
+	PutWord(file + 6, sliceCount, 2);
+	for (int i = 0; i < sliceCount; i++) {
+		unsigned char *entry = file + HEADERSIZE + i * ENTRYSIZE;
+
+		for (int j = 0; j < 4; j++)
+			entry[j] = (unsigned char)slices[i].counts[j];
+		PutWord(entry + 8, slices[i].offset, 8);
+	}
+
+	// The finished slices are probed in place while the later ones are solved.
+	CK_AttachTablebase(&tb, file, size);
+	for (int i = 0; i < sliceCount; i++) {
+		if (SolveSlice(&tb, &slices[i], file + slices[i].offset) != 0) {
+			fprintf(stderr, "out of memory\n");
+			free(file);
+			return 1;
+		}
+	}
+
+	out = fopen(path, "wb");
+	if (!out || fwrite(file, 1, size, out) != size || fclose(out) != 0) {
+		fprintf(stderr, "can't write %s\n", path);
+		free(file);
+		return 1;
+	}
+
+	printf("wrote %d slices, %lu bytes to %s\n", sliceCount, size, path);
+	free(file);
+	return 0;
+}
+
+int TBGen_Probe(const char *path, const char *position)
+{
+	static const char *results[] = { "loss", "win", "draw" };
+	CheckersTablebase tb;
+	CheckersPosition pos;
+	int result, plies;
+
+	if (CK_OpenTablebase(&tb, path) != 0) {
+		fprintf(stderr, "can't map %s\n", path);
+		return 1;
+	}
+	if (Perft_ParsePosition(&pos, position) != 0) {
+		fprintf(stderr, "can't read position %s\n", position);
+		CK_CloseTablebase(&tb);
+		return 1;
+	}
+
+	result = CK_ProbeTablebase(&tb, &pos, &plies);
+	if (result == CK_TB_UNKNOWN)
+		printf("not in the tables\n");
+	else if (result == CK_TB_DRAWN)
+		printf("draw\n");
+	else
+		printf("%s for %s in %d plies\n", results[result], pos.side ? "blue" : "red", plies);
+
+	CK_CloseTablebase(&tb);
+	return 0;
+}
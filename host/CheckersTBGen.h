@@ -0,0 +1,31 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# CheckersTBGen.h
+//# Builds the Checkers endgame tables by retrograde analysis
+//# and writes them out in the CheckersTablebase.h format.
+//###############################################################
+#pragma once
+
+// Solves every position with 2 to maxPieces pieces and writes the tables to path.
+// Returns 0 on success.
+int TBGen_Generate(const char *path, int maxPieces);
+
+// Maps the tables at path and prints what they say about a position (CheckersPerft.h format).
+int TBGen_Probe(const char *path, const char *position);
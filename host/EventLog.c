@@ -0,0 +1,166 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# EventLog.c
+//# Recording and replay of simulator input events.
+//###############################################################
+#include "EventLog.h"
+#include "HostSimulator.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char m_magic[4] = { 'P', 'E', 'V', 'L' };
+
+static unsigned long long NowMicros()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+int EventLog_OpenRecorder(EventRecorder *rec, const char *path)
+{
+	unsigned char header[8] = { 0 };
+
+	memset(rec, 0, sizeof(*rec));
+	rec->file = fopen(path, "wb");
+	if (!rec->file)
+		return -1;
+
+	memcpy(header, m_magic, sizeof(m_magic));
+	header[4] = EVENTLOG_VERSION;
+	fwrite(header, 1, sizeof(header), rec->file);
+
+	rec->lastMicros = NowMicros();
+	return 0;
+}
+
+void EventLog_Record(EventRecorder *rec, int type, int arg0, int arg1)
+{
+	unsigned char record[3 + 10];
+	unsigned long long now = NowMicros();
+	unsigned long long delta = now - rec->lastMicros;
+	int length = 3;
+
+	record[0] = (unsigned char)type;
+	record[1] = (unsigned char)arg0;
+	record[2] = (unsigned char)arg1;
+
+	// Most gaps are well under a second, so a varint keeps records to 4-6 bytes.
+	do {
+		record[length] = (unsigned char)(delta & 0x7F);
+		delta >>= 7;
+		if (delta)
+			record[length] |= 0x80;
+		length++;
+	} while (delta);
+
+	fwrite(record, 1, length, rec->file);
+	rec->lastMicros = now;
+	rec->count++;
+}
+
+void EventLog_CloseRecorder(EventRecorder *rec)
+{
+	if (rec->file)
+		fclose(rec->file);
+	rec->file = 0;
+}
+
+static void Deliver(int type, int arg0, int arg1)
+{
+	switch (type) {
+	case EV_LOADGAME: Sim_LoadGame(arg0); break;
+	case EV_BUTTON: Sim_PressButton(arg0, arg1); break;
+	case EV_LCDBUTTON: Sim_PressLCDButton(arg0); break;
+	case EV_MENUOPTION: Sim_SelectMenuOption(arg0); break;
+	case EV_LCDTIMERHITZERO: Sim_LCDTimerHitZero(arg0); break;
+	case EV_TIMERFINISHED: Sim_TimerFinished(arg0); break;
+	case EV_IDLE: Sim_Idle(); break;
+	case EV_WAKE: Sim_Wake(arg0); break;
+	case EV_EXIT: Sim_Exit(arg0); break;
+	case EV_ADVANCECLOCK: Sim_AdvanceClock(arg0); break;
+	}
+}
+
+// Sleeps until NowMicros() reaches micros, or returns straight away if it has.
+static void SleepUntilMicros(unsigned long long micros)
+{
+	struct timespec ts;
+
+	ts.tv_sec = (time_t)(micros / 1000000);
+	ts.tv_nsec = (long)(micros % 1000000) * 1000;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR)
+		;
+}
+
+long EventLog_Replay(const char *path, int bPaced)
+{
+	FILE *file = fopen(path, "rb");
+	unsigned char *data;
+	long size, pos = 8, count = 0;
+	unsigned long long start, due = 0;
+
+	if (!file)
+		return -1;
+
+	// Pull the whole log into memory first so file reads don't show up in the timings.
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	data = (unsigned char *)malloc(size > 0 ? size : 1);
+	if (!data || size < 8 || fread(data, 1, size, file) != (size_t)size || memcmp(data, m_magic, sizeof(m_magic)) != 0 || data[4] != EVENTLOG_VERSION) {
+		free(data);
+		fclose(file);
+		return -1;
+	}
+	fclose(file);
+
+	// Paced events are due at their time in the log after the start of the
+	// replay, so time spent in the callbacks doesn't push the rest back.
+	start = NowMicros();
+	while (pos + 3 < size) {
+		int type = data[pos], arg0 = data[pos + 1], arg1 = data[pos + 2];
+		unsigned long long delta = 0;
+		int shift = 0;
+
+		pos += 3;
+		while (pos < size) {
+			unsigned char b = data[pos++];
+			delta |= (unsigned long long)(b & 0x7F) << shift;
+			shift += 7;
+			if (!(b & 0x80))
+				break;
+		}
+
+		due += delta;
+		if (bPaced)
+			SleepUntilMicros(start + due);
+
+		Deliver(type, arg0, arg1);
+		count++;
+	}
+
+	free(data);
+	return count;
+}
@@ -0,0 +1,63 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# EventLog.h
+//# Binary log of every input event delivered to a game, and a
+//# driver that feeds a log back into the simulator.
+//#
+//# File layout: an 8 byte header ("PEVL", version, 3 reserved
+//# bytes) followed by one record per event:
+//#   type (1 byte), arg0 (1 byte), arg1 (1 byte),
+//#   microseconds since the previous event (LEB128 varint)
+//###############################################################
+#pragma once
+#include <stdio.h>
+
+#define EVENTLOG_VERSION 2
+
+// Event types
+#define EV_LOADGAME 0        // arg0 = game id
+#define EV_BUTTON 1          // arg0 = x, arg1 = y
+#define EV_LCDBUTTON 2       // arg0 = button id
+#define EV_MENUOPTION 3      // arg0 = slot
+#define EV_LCDTIMERHITZERO 4 // arg0 = timer id
+#define EV_TIMERFINISHED 5   // arg0 = timer id
+#define EV_IDLE 6
+#define EV_WAKE 7            // arg0 = reason
+#define EV_EXIT 8            // arg0 = reason
+#define EV_COUNT 9           // the types above are also the game's callbacks
+#define EV_ADVANCECLOCK 9    // arg0 = seconds.  Any timer hitting zero inside it isn't logged again.
+
+typedef struct
+{
+	FILE *file;
+	unsigned long long lastMicros;
+	unsigned long count;
+} EventRecorder;
+
+// Returns 0 on success, -1 if the file can't be created.
+int EventLog_OpenRecorder(EventRecorder *rec, const char *path);
+void EventLog_Record(EventRecorder *rec, int type, int arg0, int arg1);
+void EventLog_CloseRecorder(EventRecorder *rec);
+
+// Feeds every event in the log to the simulator.  With bPaced set, delivers each
+// event as long after the start of the replay as it came after the start of the
+// recording, otherwise runs flat out.  Returns the number of
+// events delivered, or -1 if the log can't be read.
+long EventLog_Replay(const char *path, int bPaced);
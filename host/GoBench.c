@@ -0,0 +1,203 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBench.c
+//# Playouts per second for GoPlayout, scores per second for
+//# GO_Score against the 9x9 bitboard, and how long a ladder
+//# across the biggest board takes to read.
+//###############################################################
+#include "GoBench.h"
+#include "GoBitboard.h"
+#include "GoPlayout.h"
+#include "GoTactics.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAXTHREADS 64
+#define SCOREPOSITIONS 256
+
+typedef struct
+{
+	int size;
+	int policy;
+	double until;
+	unsigned int random;
+	unsigned long playouts;
+	unsigned long long moves;
+	int blackWins;
+} BenchWorker;
+
+static volatile int m_scoreSink; // keeps the compiler from dropping the scoring
+
+static double NowSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void *RunPlayouts(void *arg)
+{
+	BenchWorker *worker = (BenchWorker *)arg;
+	GoBoard empty;
+	GoPlayout playout;
+
+	GO_Clear(&empty, worker->size);
+
+	// Checking the clock every 64 playouts keeps it out of the timing.
+	do {
+		for (int i = 0; i < 64; i++) {
+			GO_StartPlayout(&playout, &empty, 0);
+			worker->blackWins += GO_RunPlayout(&playout, worker->policy, 0, &worker->random) == 2;
+			worker->moves += playout.ply;
+			worker->playouts++;
+		}
+	} while (NowSeconds() < worker->until);
+	return 0;
+}
+
+// Scores the finished 9x9 positions of some light playouts over and over,
+// for half the time each way.
+static void RunScoring(double seconds)
+{
+	static GoBoard boards[SCOREPOSITIONS];
+	static GoBits stones[SCOREPOSITIONS][3];
+	GoBoard empty;
+	GoPlayout playout;
+	unsigned int random = 0x9E3779B9u;
+	unsigned char owner[GO_POINTS];
+	int score[3];
+	double rates[2];
+
+	GO_Clear(&empty, GO_BITSSIZE);
+	for (int i = 0; i < SCOREPOSITIONS; i++) {
+		GO_StartPlayout(&playout, &empty, 0);
+		GO_RunPlayout(&playout, GO_PLAYOUT_LIGHT, 0, &random);
+		boards[i] = playout.board;
+		stones[i][GO_BLACK] = GO_BitsOf(&boards[i], GO_BLACK);
+		stones[i][GO_WHITE] = GO_BitsOf(&boards[i], GO_WHITE);
+	}
+
+	for (int way = 0; way < 2; way++) {
+		double start = NowSeconds(), elapsed;
+		unsigned long scores = 0;
+
+		do {
+			for (int i = 0; i < SCOREPOSITIONS; i++) {
+				if (way == 0)
+					GO_Score(&boards[i], owner, score);
+				else
+					GO_BitsScore(stones[i][GO_BLACK], stones[i][GO_WHITE], owner, score);
+				m_scoreSink = score[GO_BLACK];
+			}
+			scores += SCOREPOSITIONS;
+			elapsed = NowSeconds() - start;
+		} while (elapsed < seconds / 2);
+		rates[way] = scores / elapsed;
+	}
+
+	printf(" 9x9  scoring  GO_Score %12.0f scores/s  GO_BitsScore %12.0f scores/s %6.1fx\n",
+		rates[0], rates[1], rates[1] / rates[0]);
+}
+
+// A lone white stone in the corner with black to start the ladder, which runs
+// right across the biggest board the build holds to the far edge.
+static void RunLadder(double seconds)
+{
+	static const int black[3][2] = { { 2, 3 }, { 3, 2 }, { 4, 2 } };
+	static GoUndo undo;
+	GoBoard board;
+	GoReadResult result;
+	double start = NowSeconds(), elapsed;
+	unsigned long reads = 0;
+
+	GO_Clear(&board, GO_MAXSIZE);
+	GO_Play(&board, GO_PASS, 0);
+	GO_Play(&board, GO_Point(3, 3), 0);
+	for (int i = 0; i < 3; i++) {
+		GO_Play(&board, GO_Point(black[i][0], black[i][1]), 0);
+		GO_Play(&board, GO_PASS, 0);
+	}
+	GO_ResetUndo(&undo);
+
+	do {
+		for (int i = 0; i < 64; i++)
+			GO_ReadString(&board, &undo, GO_Point(3, 3), GO_LADDERLIBS, 0, &result);
+		reads += 64;
+		elapsed = NowSeconds() - start;
+	} while (elapsed < seconds);
+
+	printf("%2dx%-2d ladder   %s in %lu nodes %12.0f reads/s %8.2f us each\n",
+		GO_MAXSIZE, GO_MAXSIZE, result.result == GO_READ_CAPTURED ? "captured" : "escapes ", result.nodes, reads / elapsed, elapsed * 1e6 / reads);
+}
+
+int GoBench_Run(double seconds, int threads)
+{
+	static const int sizes[2] = { 9, 19 };
+	static const char *policies[2] = { "light", "weighted" };
+	BenchWorker workers[MAXTHREADS];
+	pthread_t ids[MAXTHREADS];
+
+	if (threads < 1)
+		threads = 1;
+	if (threads > MAXTHREADS)
+		threads = MAXTHREADS;
+
+	for (int s = 0; s < 2; s++) {
+		if (sizes[s] > GO_MAXSIZE) {
+			printf("%2dx%-2d skipped, the build only holds boards up to %dx%d (-DGO_MAXSIZE)\n",
+				sizes[s], sizes[s], GO_MAXSIZE, GO_MAXSIZE);
+			continue;
+		}
+		for (int policy = GO_PLAYOUT_LIGHT; policy <= GO_PLAYOUT_WEIGHTED; policy++) {
+			double start = NowSeconds(), elapsed;
+			unsigned long playouts = 0;
+			unsigned long long moves = 0;
+			int blackWins = 0;
+
+			for (int i = 0; i < threads; i++) {
+				workers[i].size = sizes[s];
+				workers[i].policy = policy;
+				workers[i].until = start + seconds;
+				workers[i].random = 0x9E3779B9u * (i + 1);
+				workers[i].playouts = 0;
+				workers[i].moves = 0;
+				workers[i].blackWins = 0;
+				pthread_create(&ids[i], 0, RunPlayouts, &workers[i]);
+			}
+			for (int i = 0; i < threads; i++) {
+				pthread_join(ids[i], 0);
+				playouts += workers[i].playouts;
+				moves += workers[i].moves;
+				blackWins += workers[i].blackWins;
+			}
+			elapsed = NowSeconds() - start;
+
+			printf("%2dx%-2d %-8s %2d threads %10lu playouts %8.3f s %12.0f playouts/s %6.1f moves each %5.1f%% black wins\n",
+				sizes[s], sizes[s], policies[policy], threads, playouts, elapsed, elapsed > 0 ? playouts / elapsed : 0.0,
+				playouts ? (double)moves / playouts : 0.0, playouts ? 100.0 * blackWins / playouts : 0.0);
+		}
+	}
+	RunScoring(seconds);
+	RunLadder(seconds);
+	return 0;
+}
@@ -0,0 +1,30 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoBench.h
+//# Times the Go playout kernel: playouts per second from the
+//# empty 9x9 and 19x19 boards, with each playout policy, then
+//# 9x9 scoring with and without the bitboard, then a ladder read.
+//###############################################################
+#pragma once
+
+// Plays for the given number of seconds per board size and policy, on
+// that many threads at once, and prints the rates.  Scoring and the ladder
+// run on one thread for the same time each.  Returns 0.
+int GoBench_Run(double seconds, int threads);
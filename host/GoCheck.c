@@ -0,0 +1,261 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# GoCheck.c
+//# Plays random games to the longest a game may last, checking
+//# superko still refuses repeats right up to the end, scores and
+//# captures on 9x9 both with GoBoard and with the bitboard, and keeps
+//# Benson's algorithm up to date a move at a time against working
+//# it out afresh.
+//###############################################################
+#include "GoCheck.h"
+#include "GoBenson.h"
+#include "GoBitboard.h"
+#include "GoBoard.h"
+#include "GoPlayout.h"
+
+#include <stdio.h>
+
+#define SUPERKOGAMES 64
+#define SCOREGAMES 256
+#define BENSONGAMES 512
+
+// Plays out one game, every move legal and new, on the biggest board the
+// build holds.  Whenever a move starts a ko, both sides pass so the ko rule
+// lets the stone straight back, and the retake must still be refused because
+// it brings back the position before.  Returns -1 if superko ever failed,
+// or else the number of retakes refused once the game was nearly over.
+static int PlaySuperkoGame(unsigned int random)
+{
+	static unsigned long long keys[GO_MAXPOSITIONS];
+	static GoHistory history;
+	GoBoard board;
+	short moves[GO_MAXSTONES];
+	int passes = 0, late = 0;
+
+	GO_Clear(&board, GO_MAXSIZE);
+	GO_ResetHistory(&history, &board);
+	keys[0] = board.hash;
+
+	for (;;) {
+		int count = 0, ko;
+
+		for (int p = 0; p < GO_POINTS; p++) {
+			if (board.color[p] == GO_EMPTY && GO_IsLegal(&board, p) && !GO_Seen(&history, GO_HashAfter(&board, p)))
+				moves[count++] = p;
+		}
+		if (!count) {
+			GO_Play(&board, GO_PASS, 0);
+			if (++passes == 2)
+				return late; // ended before it ran its length
+			continue;
+		}
+		passes = 0;
+
+		random = random * 1103515245u + 12345u;
+		GO_Play(&board, moves[(random >> 8) % count], 0);
+		keys[history.count] = board.hash;
+		if (!GO_RecordPosition(&history, &board))
+			break;
+
+		ko = board.ko;
+		if (ko != GO_PASS) {
+			GO_Play(&board, GO_PASS, 0);
+			GO_Play(&board, GO_PASS, 0);
+			if (!GO_IsLegal(&board, ko) || !GO_Seen(&history, GO_HashAfter(&board, ko)))
+				return -1;
+			if (history.count > GO_MAXPOSITIONS - GO_MAXSTONES)
+				late++;
+		}
+	}
+
+	// Full: every position is still known, and no more are taken.
+	if (history.count != GO_MAXPOSITIONS || GO_RecordPosition(&history, &board))
+		return -1;
+	for (int i = 0; i < history.count; i++) {
+		if (!GO_Seen(&history, keys[i]))
+			return -1;
+	}
+	return late;
+}
+
+// Superko has to hold for the whole of the longest game allowed, and some
+// game has to try a repeat in its last GO_MAXSTONES positions to show it.
+static int CheckSuperko()
+{
+	int games = 0, late = 0;
+
+	for (; games < SUPERKOGAMES && !late; games++) {
+		late = PlaySuperkoGame(0x9E3779B9u * (games + 1));
+		if (late < 0) {
+			printf("superko  FAILED in game %d\n", games + 1);
+			return 1;
+		}
+	}
+
+	if (!late) {
+		printf("superko  FAILED, no repeat tried late in %d games\n", games);
+		return 1;
+	}
+	printf("superko  ok, %d games of %d positions on %dx%d, %d late repeats refused\n",
+		games, GO_MAXPOSITIONS, GO_MAXSIZE, GO_MAXSIZE, late);
+	return 0;
+}
+
+// The stones GO_BitsCaptures says p takes on board, as a list from GO_Play
+// would have them.  Returns how many.
+static int BitsCaptured(const GoBoard *board, int p, short *captured)
+{
+	GoBits taken = GO_BitsCaptures(GO_BitsOf(board, board->toMove), GO_BitsOf(board, 3 - board->toMove), GO_BitsPoint(GO_PointX(p), GO_PointY(p)));
+	int count = 0;
+
+	for (int q = 0; q < GO_POINTS; q++) {
+		if (board->color[q] != GO_BORDER && !GO_BitsIsEmpty(GO_BitsAnd(taken, GO_BitsPoint(GO_PointX(q), GO_PointY(q)))))
+			captured[count++] = (short)q;
+	}
+	return count;
+}
+
+// GO_BitsScore has to agree with GO_Score, owner of every point included,
+// after every move of some playouts on 9x9, and GO_BitsCaptures with the
+// stones GO_Play takes on every move.
+static int CheckBitboard()
+{
+	GoBoard empty, before;
+	GoPlayout playout;
+	unsigned int random = 0x9E3779B9u;
+	unsigned char owner[2][GO_POINTS], listed[GO_POINTS];
+	short captured[2][GO_MAXSTONES];
+	int score[2][3], taken[2], same, p;
+	unsigned long positions = 0, captures = 0;
+
+	if (!GO_Clear(&empty, GO_BITSSIZE)) {
+		printf("bitboard skipped, the build only holds boards up to %dx%d\n", GO_MAXSIZE, GO_MAXSIZE);
+		return 0;
+	}
+
+	for (int game = 0; game < SCOREGAMES; game++) {
+		GO_StartPlayout(&playout, &empty, 0);
+		do {
+			before = playout.board;
+			p = GO_PlayoutMove(&playout, game % 2 ? GO_PLAYOUT_WEIGHTED : GO_PLAYOUT_LIGHT, &random);
+			if (p != GO_PASS) {
+				taken[1] = BitsCaptured(&before, p, captured[1]);
+				taken[0] = GO_Play(&before, p, captured[0]);
+
+				// Same stones, whatever order they're listed in.
+				same = taken[0] == taken[1];
+				for (int q = 0; q < GO_POINTS; q++)
+					listed[q] = 0;
+				for (int i = 0; same && i < taken[0]; i++)
+					listed[captured[0][i]] = 1;
+				for (int i = 0; same && i < taken[1]; i++)
+					same = listed[captured[1][i]];
+				if (!same) {
+					printf("captures FAILED in game %d at move %d on (%d,%d): GO_Play took %d, GO_BitsCaptures %d\n", game + 1, playout.ply,
+						GO_PointX(p), GO_PointY(p), taken[0], taken[1]);
+					return 1;
+				}
+				captures += taken[0];
+			}
+
+			GO_Score(&playout.board, owner[0], score[0]);
+			GO_BitsScore(GO_BitsOf(&playout.board, GO_BLACK), GO_BitsOf(&playout.board, GO_WHITE), owner[1], score[1]);
+			positions++;
+
+			same = score[0][GO_BLACK] == score[1][GO_BLACK] && score[0][GO_WHITE] == score[1][GO_WHITE];
+			for (int p = 0; p < GO_POINTS; p++)
+				same &= owner[0][p] == owner[1][p];
+			if (!same) {
+				printf("scoring  FAILED in game %d at move %d: GO_Score %d-%d, GO_BitsScore %d-%d\n", game + 1, playout.ply,
+					score[0][GO_BLACK], score[0][GO_WHITE], score[1][GO_BLACK], score[1][GO_WHITE]);
+				return 1;
+			}
+		} while (playout.passes < 2 && playout.ply < 3 * GO_BITSSIZE * GO_BITSSIZE);
+	}
+
+	printf("bitboard ok, GO_BitsScore agrees with GO_Score on %lu 9x9 positions, GO_BitsCaptures with GO_Play on %lu captured stones\n",
+		positions, captures);
+	return 0;
+}
+
+// GO_UpdateBenson has to agree with GO_ResetBenson after every move of some
+// playouts on 5x5 and 9x9, with a string now and then taken off as dead
+// stones are at the end of a game.
+static int CheckBenson()
+{
+	static const int sizes[] = { 5, 9 };
+	GoBoard board;
+	GoPlayout playout;
+	GoBenson kept, fresh;
+	unsigned int random = 0x9E3779B9u;
+	unsigned long positions = 0, settled = 0;
+
+	for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+		int size = sizes[s];
+
+		if (!GO_Clear(&board, size))
+			continue;
+
+		for (int game = 0; game < BENSONGAMES; game++) {
+			GO_StartPlayout(&playout, &board, 0);
+			GO_ResetBenson(&kept, &playout.board);
+
+			for (int step = 0; playout.passes < 2 && step < 3 * size * size; step++) {
+				int p = GO_PASS;
+
+				random = random * 1103515245u + 12345u;
+				if ((random >> 8) % 32 == 0)
+					p = GO_Point((random >> 13) % size, (random >> 18) % size);
+
+				// Taking stones off leaves the playout's empty list behind, so it starts again from there.
+				if (p != GO_PASS && playout.board.color[p] != GO_EMPTY) {
+					GoBoard taken = playout.board;
+
+					GO_RemoveString(&taken, p, 0);
+					GO_StartPlayout(&playout, &taken, 0);
+				}
+				else
+					GO_PlayoutMove(&playout, GO_PLAYOUT_WEIGHTED, &random);
+
+				GO_UpdateBenson(&kept, &playout.board);
+				GO_ResetBenson(&fresh, &playout.board);
+				positions++;
+
+				for (int q = 0; q < GO_POINTS; q++) {
+					if (kept.owner[q] != fresh.owner[q]) {
+						printf("benson   FAILED on %dx%d in game %d at step %d: (%d,%d) kept %d, afresh %d\n", size, size,
+							game + 1, step, GO_PointX(q), GO_PointY(q), kept.owner[q], fresh.owner[q]);
+						return 1;
+					}
+					if (fresh.owner[q] != GO_EMPTY)
+						settled++;
+				}
+			}
+		}
+	}
+
+	printf("benson   ok, GO_UpdateBenson agrees with GO_ResetBenson on %lu positions, %lu settled points\n", positions, settled);
+	return 0;
+}
+
+int GoCheck_Run()
+{
+	return CheckSuperko() + CheckBitboard() + CheckBenson();
+}
@@ -0,0 +1,456 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# HostSimulator.c
+//# Host-side implementation of the StandardGameIncludes.h API.
+//# The LED matrix, LCD and menu are plain memory, so a driver
+//# can push events into a game as fast as the game can take them.
+//###############################################################
+#include "HostSimulator.h"
+#include "CallbackStats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+BoardGameInfo BoardGameInfoList[MAX_GAMES];
+
+static SimTable m_defaultTable;
+static _Thread_local SimTable *t_pTable;
+static _Thread_local void *t_pScratch;
+static _Thread_local unsigned long t_scratchSize;
+static void (*m_pLoadHook)(int gameID);
+
+int g_bSimPrintDebug = 0;
+
+static SimTable *ActiveTable()
+{
+	return t_pTable ? t_pTable : &m_defaultTable;
+}
+
+static int OnBoard(const SimTable *table, int x, int y)
+{
+	return x >= 0 && y >= 0 && x < table->width && y < table->height;
+}
+
+// ----------------------------------------------------------------------------
+// Board
+// ----------------------------------------------------------------------------
+
+void SetBoardSize(int width, int height)
+{
+	SimTable *table = ActiveTable();
+
+	if (width > SIM_MAX_BOARDSIZE)
+		width = SIM_MAX_BOARDSIZE;
+	if (height > SIM_MAX_BOARDSIZE)
+		height = SIM_MAX_BOARDSIZE;
+
+	table->width = width;
+	table->height = height;
+}
+
+void IlluminateBoard(int color)
+{
+	SimTable *table = ActiveTable();
+
+	memset(table->leds, color, sizeof(table->leds));
+	table->hwCalls[HW_ILLUMINATEBOARD]++;
+}
+
+void IlluminateButton(int x, int y, int color)
+{
+	SimTable *table = ActiveTable();
+
+	// The games routinely probe one or two cells past the edge, so quietly ignore those.
+	if (OnBoard(table, x, y))
+		table->leds[x][y] = (unsigned char)color;
+	table->hwCalls[HW_ILLUMINATEBUTTON]++;
+}
+
+int GetButtonColorAtPos(int x, int y)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_GETBUTTONCOLORATPOS]++;
+
+	if (!OnBoard(table, x, y))
+		return GC_INVALID;
+
+	return table->leds[x][y];
+}
+
+void SetColorMode(int mode)
+{
+	ActiveTable()->colorMode = mode;
+}
+
+// ----------------------------------------------------------------------------
+// LCD
+// ----------------------------------------------------------------------------
+
+void SetLCDGameMessage(int message)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_OTHERLCD]++;
+	table->gameMessage = message;
+}
+
+void SetLCDGameDisplayFormat(int format)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_OTHERLCD]++;
+	table->displayFormat = format;
+}
+
+void SetLCDScoreDisplayValue(int id, int value)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_SETLCDSCOREDISPLAYVALUE]++;
+
+	if (id >= 0 && id < 2)
+		table->scores[id] = value;
+}
+
+void SetLCDTimerValue(int id, int seconds)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_OTHERLCD]++;
+
+	if (id >= 0 && id < 2)
+		table->timerValue[id] = seconds;
+}
+
+void SetLCDTimerCountMode(int id, int mode)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_OTHERLCD]++;
+
+	if (id >= 0 && id < 2)
+		table->timerMode[id] = mode;
+}
+
+// ----------------------------------------------------------------------------
+// Menu
+// ----------------------------------------------------------------------------
+
+void ClearAllMenuOptions()
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_MENU]++;
+	memset(table->menu, 0, sizeof(table->menu));
+}
+
+void RegisterMenuOptionWithStringParameter(int stringPreset, int imageID, int parameterPreset, int slot)
+{
+	SimTable *table = ActiveTable();
+
+	table->hwCalls[HW_MENU]++;
+
+	if (slot < 0 || slot >= SIM_MAX_MENUOPTIONS)
+		return;
+
+	table->menu[slot].used = 1;
+	table->menu[slot].stringPreset = stringPreset;
+	table->menu[slot].imageID = imageID;
+	table->menu[slot].parameterPreset = parameterPreset;
+}
+
+void RegisterMenuOption(int stringPreset, int imageID, int slot)
+{
+	RegisterMenuOptionWithStringParameter(stringPreset, imageID, -1, slot);
+}
+
+// ----------------------------------------------------------------------------
+// Misc
+// ----------------------------------------------------------------------------
+
+void PlaySoundPreset(int id)
+{
+	ActiveTable()->lastSound = id;
+}
+
+void PrintDebugMessage(const char *message)
+{
+	if (g_bSimPrintDebug)
+		fputs(message, stdout);
+}
+
+// ----------------------------------------------------------------------------
+// Tables
+// ----------------------------------------------------------------------------
+
+SimTable *Sim_CreateTable()
+{
+	return (SimTable *)calloc(1, sizeof(SimTable));
+}
+
+void Sim_DestroyTable(SimTable *table)
+{
+	if (t_pTable == table)
+		t_pTable = 0;
+
+	free(table->gameContext);
+	free(table->pStats);
+	free(table);
+}
+
+void Sim_BindTable(SimTable *table)
+{
+	t_pTable = table;
+}
+
+void *Sim_GetGameContext(unsigned int size)
+{
+	SimTable *table = ActiveTable();
+
+	if (table->gameContextSize != size) {
+		free(table->gameContext);
+		table->gameContext = calloc(1, size);
+		table->gameContextSize = size;
+	}
+
+	return table->gameContext;
+}
+
+void *Sim_GetScratch(unsigned long size)
+{
+	// The games have no way to go on without it, so running out ends the simulator.
+	if (size > t_scratchSize) {
+		free(t_pScratch);
+		t_pScratch = malloc(size);
+		if (!t_pScratch) {
+			fprintf(stderr, "out of memory for %lu bytes of game scratch\n", size);
+			abort();
+		}
+		t_scratchSize = size;
+	}
+
+	return t_pScratch;
+}
+
+// Clears the hardware and drops the old game's context, but keeps recording and stats going.
+static void ResetTable(SimTable *table)
+{
+	EventRecorder *pRecorder = table->pRecorder;
+	struct StatsSet *pStats = table->pStats;
+
+	free(table->gameContext);
+	memset(table, 0, sizeof(*table));
+
+	table->pRecorder = pRecorder;
+	table->pStats = pStats;
+}
+
+// ----------------------------------------------------------------------------
+// Driver
+// ----------------------------------------------------------------------------
+
+void Sim_SetRecorder(EventRecorder *rec)
+{
+	ActiveTable()->pRecorder = rec;
+}
+
+void Sim_EnableStats(int bEnable)
+{
+	SimTable *table = ActiveTable();
+
+	if (bEnable && !table->pStats)
+		table->pStats = (StatsSet *)calloc(1, sizeof(StatsSet));
+	else if (!bEnable) {
+		free(table->pStats);
+		table->pStats = 0;
+	}
+}
+
+// Every event goes through these two around the game's callback.  The event
+// types double as callback ids since there's one of each.
+static void BeginEvent(SimTable *table, StatsProbe *probe, int type, int arg0, int arg1)
+{
+	if (table->pRecorder)
+		EventLog_Record(table->pRecorder, type, arg0, arg1);
+	if (table->pStats)
+		Stats_Begin(probe, table->hwCalls);
+}
+
+static void EndEvent(SimTable *table, StatsProbe *probe, int type)
+{
+	if (table->pStats)
+		Stats_End(table->pStats, probe, table->gameID, type, table->hwCalls);
+}
+
+int Sim_LoadGame(int gameID)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+	int result;
+
+	if (table->pRecorder)
+		EventLog_Record(table->pRecorder, EV_LOADGAME, gameID, 0);
+
+	ResetTable(table);
+	table->gameID = gameID;
+
+	if (gameID < 0 || gameID >= MAX_GAMES || BoardGameInfoList[gameID].p_OnGameLoaded == 0)
+		return -1;
+
+	if (table->pStats)
+		Stats_Begin(&probe, table->hwCalls);
+	result = BoardGameInfoList[gameID].p_OnGameLoaded();
+	EndEvent(table, &probe, EV_LOADGAME);
+
+	if (m_pLoadHook)
+		m_pLoadHook(gameID);
+
+	return result;
+}
+
+void Sim_SetLoadHook(void (*hook)(int gameID))
+{
+	m_pLoadHook = hook;
+}
+
+void Sim_PressButton(int x, int y)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_BUTTON, x, y);
+	BoardGameInfoList[table->gameID].p_OnButtonPressed(x, y);
+	EndEvent(table, &probe, EV_BUTTON);
+}
+
+void Sim_PressLCDButton(int id)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_LCDBUTTON, id, 0);
+	BoardGameInfoList[table->gameID].p_OnLCDButtonPressed(id);
+	EndEvent(table, &probe, EV_LCDBUTTON);
+}
+
+void Sim_SelectMenuOption(int slot)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_MENUOPTION, slot, 0);
+	BoardGameInfoList[table->gameID].p_OnMenuOptionSelected(slot);
+	EndEvent(table, &probe, EV_MENUOPTION);
+}
+
+void Sim_TimerFinished(int id)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_TIMERFINISHED, id, 0);
+	BoardGameInfoList[table->gameID].p_OnTimerFinished(id);
+	EndEvent(table, &probe, EV_TIMERFINISHED);
+}
+
+void Sim_LCDTimerHitZero(int id)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_LCDTIMERHITZERO, id, 0);
+	BoardGameInfoList[table->gameID].p_OnLCDTimerHitZero(id);
+	EndEvent(table, &probe, EV_LCDTIMERHITZERO);
+}
+
+void Sim_Idle()
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_IDLE, 0, 0);
+	BoardGameInfoList[table->gameID].p_OnIdle();
+	EndEvent(table, &probe, EV_IDLE);
+}
+
+void Sim_Wake(int reason)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_WAKE, reason, 0);
+	BoardGameInfoList[table->gameID].p_OnWake(reason);
+	EndEvent(table, &probe, EV_WAKE);
+}
+
+void Sim_Exit(int reason)
+{
+	SimTable *table = ActiveTable();
+	StatsProbe probe;
+
+	BeginEvent(table, &probe, EV_EXIT, reason, 0);
+	BoardGameInfoList[table->gameID].p_OnExit(reason);
+	EndEvent(table, &probe, EV_EXIT);
+}
+
+void Sim_AdvanceClock(int seconds)
+{
+	SimTable *table = ActiveTable();
+	EventRecorder *pRecorder = table->pRecorder;
+
+	// The log holds one byte of seconds per advance.
+	while (seconds > 255) {
+		Sim_AdvanceClock(255);
+		seconds -= 255;
+	}
+
+	// Replaying the advance fires the same timers, so they aren't logged themselves.
+	if (pRecorder)
+		EventLog_Record(pRecorder, EV_ADVANCECLOCK, seconds, 0);
+	table->pRecorder = 0;
+
+	for (int i = 0; i < 2; i++) {
+		if (table->timerMode[i] != SIM_TIMER_COUNTDOWN || table->timerValue[i] <= 0)
+			continue;
+
+		table->timerValue[i] -= seconds;
+		if (table->timerValue[i] <= 0) {
+			table->timerValue[i] = 0;
+			table->timerMode[i] = SIM_TIMER_STOPPED;
+			Sim_LCDTimerHitZero(i);
+		}
+	}
+
+	table->pRecorder = pRecorder;
+}
+
+const SimTable *Sim_GetTable()
+{
+	return ActiveTable();
+}
+
+int Sim_IsGameInProgress()
+{
+	SimTable *table = ActiveTable();
+
+	return table->menu[0].used && table->menu[0].stringPreset == SPT_OPTIONS_RESTART;
+}
@@ -0,0 +1,132 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# HostSimulator.h
+//# In-memory implementation of the table hardware, plus the
+//# functions a host program uses to drive a registered game.
+//#
+//# Any number of tables can exist at once.  Each thread has one
+//# bound table which receives both its hardware calls and the
+//# events it delivers, so tables can be spread over a thread pool
+//# as long as no table is bound to two threads at the same time.
+//###############################################################
+#pragma once
+#include "StandardGameIncludes.h"
+#include "EventLog.h"
+
+#define SIM_MAX_MENUOPTIONS 8
+
+// Hardware calls counted by the simulator.
+#define HW_GETBUTTONCOLORATPOS 0
+#define HW_ILLUMINATEBUTTON 1
+#define HW_ILLUMINATEBOARD 2
+#define HW_SETLCDSCOREDISPLAYVALUE 3
+#define HW_OTHERLCD 4 // messages, timers and display format
+#define HW_MENU 5
+#define HW_COUNT 6
+
+// LCD timer count modes as the games use them.
+#define SIM_TIMER_STOPPED 1
+#define SIM_TIMER_COUNTDOWN 3
+
+typedef struct
+{
+	int used;
+	int stringPreset;
+	int imageID;
+	int parameterPreset;
+} SimMenuOption;
+
+struct StatsSet;
+
+// Everything the physical table would be showing, plus the game running on it.
+typedef struct
+{
+	int gameID;
+	void *gameContext; // the loaded game's state, see GameContext.h
+	unsigned int gameContextSize;
+
+	int width, height;
+	unsigned char leds[SIM_MAX_BOARDSIZE][SIM_MAX_BOARDSIZE];
+	unsigned long hwCalls[HW_COUNT];
+
+	int gameMessage;
+	int displayFormat;
+	int scores[2];
+	int timerValue[2];
+	int timerMode[2];
+	int colorMode;
+	int lastSound;
+
+	SimMenuOption menu[SIM_MAX_MENUOPTIONS];
+
+	EventRecorder *pRecorder;
+	struct StatsSet *pStats; // 0 unless stats are enabled
+} SimTable;
+
+// Set to 1 to echo PrintDebugMessage to stdout.
+extern int g_bSimPrintDebug;
+
+// Tables.  Until a thread binds one of its own it uses a built-in default table.
+SimTable *Sim_CreateTable();
+void Sim_DestroyTable(SimTable *table);
+void Sim_BindTable(SimTable *table);
+
+// Storage for the loaded game's context on the bound table, zeroed on first use
+// and freed when the next game loads.
+void *Sim_GetGameContext(unsigned int size);
+
+// Scratch memory for whatever game the calling thread is running, at least
+// size bytes and not cleared.  Kept for the thread and only grown, so it
+// holds nothing from one callback to the next.
+void *Sim_GetScratch(unsigned long size);
+
+// Resets the bound table and makes gameID the active game.  Returns OnGameLoaded's result.
+int Sim_LoadGame(int gameID);
+
+// Called on the bound table after every Sim_LoadGame, replays included, for
+// the host to change a game's settings there.  Set it before any table starts.
+void Sim_SetLoadHook(void (*hook)(int gameID));
+
+// Event delivery.  Each one calls straight into the game's registered callback.
+void Sim_PressButton(int x, int y);
+void Sim_PressLCDButton(int id);
+void Sim_SelectMenuOption(int slot);
+void Sim_TimerFinished(int id);
+void Sim_LCDTimerHitZero(int id);
+void Sim_Idle();
+void Sim_Wake(int reason);
+void Sim_Exit(int reason);
+
+// Every event the bound table receives from here on is also written to rec.  Pass 0 to stop recording.
+void Sim_SetRecorder(EventRecorder *rec);
+
+// Times every callback on the bound table and counts its hardware calls into the table's StatsSet.
+void Sim_EnableStats(int bEnable);
+
+// Runs any counting-down LCD timers forward, firing OnLCDTimerHitZero when one expires.
+// Recorded as one EV_ADVANCECLOCK, which fires the same timers again on replay.
+void Sim_AdvanceClock(int seconds);
+
+// Read-only view of the bound table.
+const SimTable *Sim_GetTable();
+
+// Every game registers "Restart" in slot 0 for the game phase and "Start" in setup,
+// so this tells a driver whether a game is being played or has ended.
+int Sim_IsGameInProgress();
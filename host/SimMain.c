@@ -0,0 +1,457 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# SimMain.c
+//# Loads the games into the host simulator and hammers them with
+//# random input, reporting how many events per second they take.
+//#
+//# Build from the repository root:
+//#   cc -O2 -I. -Ihost -o pinksim host/*.c *.c -lpthread
+//# Run:
+//#   ./pinksim [game name|all] [events] [seed]
+//#   ./pinksim stats [game name|all] [events] [seed]
+//#   ./pinksim [stats] tables <game name|all> <tables> <threads> [events per table] [seed]
+//#   ./pinksim record <log file> <game name> [events] [seed]
+//#   ./pinksim replay <log file> [paced]     (always prints stats)
+//#   ./pinksim perft <depth> [hash MB] [position]
+//#   ./pinksim perft <english|russian|brazilian|international> <depth>
+//#   ./pinksim tbgen <tablebase file> [pieces]
+//#   ./pinksim tbprobe <tablebase file> <position>
+//#   ./pinksim bookgen <book file> <self-play games> [plies] [game records file] [seed]
+//#   ./pinksim gobench [seconds] [threads]
+//#   ./pinksim gocheck
+//#
+//# Set PINKSIM_CHECKERS_TB to a tablebase file for Checkers to
+//# adjudicate endgames with it and the computer to play them,
+//# and PINKSIM_CHECKERS_BOOK to a book file for the computer and
+//# the suggest move option to open from.  PINKSIM_CHECKERS_MOVEMS
+//# sets how many milliseconds those think for on every table.
+//# PINKSIM_GO_THREADS sets how many threads the Go computer
+//# player searches with.
+//###############################################################
+#include "HostSimulator.h"
+#include "CallbackStats.h"
+#include "CheckersPerft.h"
+#include "CheckersTBGen.h"
+#include "CheckersBookBuilder.h"
+#include "CheckersBook.h"
+#include "CheckersTablebase.h"
+#include "DraughtsEngine.h"
+#include "GoBench.h"
+#include "GoCheck.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void Checkers_RegisterGame(int id);
+void ChineseCheckers_RegisterGame(int id);
+void Go_RegisterGame(int id);
+void Popout_RegisterGame(int id);
+void StraightEdge_RegisterGame(int id);
+void Checkers_SetTablebase(const CheckersTablebase *tb);
+void Checkers_SetBook(const CheckersBook *book);
+void Checkers_SetMoveTime(long millis);
+void Go_SetSearchThreads(int threads);
+
+#define GAMEID_CHECKERS 0
+#define GAMEID_CHINESECHECKERS 1
+#define GAMEID_GO 2
+#define GAMEID_POPOUT 3
+#define GAMEID_STRAIGHTEDGE 4
+#define GAMEID_COUNT 5
+
+static const char *m_gameNames[GAMEID_COUNT] = { "checkers", "chinesecheckers", "go", "popout", "straightedge" };
+
+// Per thread, so each worker's tables see the same input whatever the others do.
+static _Thread_local unsigned int m_rng = 1;
+
+static CheckersTablebase m_tablebase;
+static CheckersBook m_book;
+static long m_checkersMoveMillis; // 0 leaves the game's own
+static int m_bStats;
+
+// xorshift, so a seed always reproduces the same run
+static unsigned int NextRandom()
+{
+	m_rng ^= m_rng << 13;
+	m_rng ^= m_rng >> 17;
+	m_rng ^= m_rng << 5;
+	return m_rng;
+}
+
+static double NowSeconds()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// One of the menu options the game has up, chosen by r.  Slot 0 if none are.
+static int RandomMenuSlot(const SimTable *table, unsigned int r)
+{
+	int slots[SIM_MAX_MENUOPTIONS], count = 0;
+
+	for (int i = 0; i < SIM_MAX_MENUOPTIONS; i++) {
+		if (table->menu[i].used)
+			slots[count++] = i;
+	}
+	return count ? slots[r % count] : 0;
+}
+
+// The first menu option showing On, such as the computer player, or -1.
+static int MenuSlotOn(const SimTable *table)
+{
+	for (int i = 0; i < SIM_MAX_MENUOPTIONS; i++) {
+		if (table->menu[i].used && table->menu[i].parameterPreset == SPT_UTIL_ON)
+			return i;
+	}
+	return -1;
+}
+
+// Feeds one random event to the active game.  Mostly board presses, with the
+// occasional LCD button, clock tick or menu selection mixed in.
+//
+// Between games it mostly starts the next one, but now and then flips a
+// setting first, which is how the computer player comes on.  A computer game
+// runs a search every other move, so settings left on are usually turned back
+// off before the next game and only a game or so in a hundred has one.  The
+// second LCD button and the in-game menu, where the hints are, are rare for
+// the same reason.
+static void SendRandomEvent()
+{
+	const SimTable *table = Sim_GetTable();
+	unsigned int r = NextRandom();
+
+	if (!Sim_IsGameInProgress()) {
+		int on = MenuSlotOn(table);
+
+		if (on >= 0 && r % 4 != 0)
+			Sim_SelectMenuOption(on);
+		else if (r % 64 == 0)
+			Sim_SelectMenuOption(RandomMenuSlot(table, r >> 8));
+		else
+			Sim_SelectMenuOption(0);
+		return;
+	}
+
+	switch (r % 64) {
+	case 0: Sim_PressLCDButton(LCDB_EXTRA1); break;
+	case 1: Sim_AdvanceClock(30); break;
+	case 2:
+		if ((r >> 8) % 256 == 0)
+			Sim_SelectMenuOption(0);
+		else
+			Sim_PressButton((r >> 8) % table->width, (r >> 16) % table->height);
+		break;
+	case 3:
+		if ((r >> 8) % 64 == 0)
+			Sim_PressLCDButton(LCDB_EXTRA2);
+		else
+			Sim_PressButton((r >> 8) % table->width, (r >> 16) % table->height);
+		break;
+	case 4:
+		if ((r >> 8) % 64 == 0)
+			Sim_SelectMenuOption(RandomMenuSlot(table, r >> 14));
+		else
+			Sim_PressButton((r >> 8) % table->width, (r >> 16) % table->height);
+		break;
+	default: Sim_PressButton((r >> 8) % table->width, (r >> 16) % table->height); break;
+	}
+}
+
+// Every table gets the settings from the environment as its game loads.
+static void OnGameLoaded(int gameID)
+{
+	if (gameID == GAMEID_CHECKERS && m_checkersMoveMillis > 0)
+		Checkers_SetMoveTime(m_checkersMoveMillis);
+}
+
+static void RunGame(int gameID, long events)
+{
+	long games = 0;
+	double start, elapsed;
+
+	Sim_LoadGame(gameID);
+
+	start = NowSeconds();
+	for (long i = 0; i < events; i++) {
+		int wasPlaying = Sim_IsGameInProgress();
+		SendRandomEvent();
+		if (wasPlaying && !Sim_IsGameInProgress())
+			games++;
+	}
+	elapsed = NowSeconds() - start;
+
+	printf("%-16s %10ld events %8.3f s %12.0f events/s %8ld games finished %6.2f LED writes/event\n",
+		m_gameNames[gameID], events, elapsed, elapsed > 0 ? events / elapsed : 0.0, games,
+		(double)(Sim_GetTable()->hwCalls[HW_ILLUMINATEBUTTON] + Sim_GetTable()->hwCalls[HW_ILLUMINATEBOARD]) / events);
+}
+
+typedef struct
+{
+	int gameID;
+	int tableCount;
+	long events; // per table
+	unsigned int seed;
+
+	long games;
+	StatsSet *pStats;
+} TableWorker;
+
+// One thread's share of the tables, all playing gameID.  Events are dealt out
+// round-robin so every table stays in play for the whole run.
+static void *RunTables(void *arg)
+{
+	TableWorker *worker = (TableWorker *)arg;
+	SimTable **tables = (SimTable **)calloc(worker->tableCount, sizeof(SimTable *));
+
+	m_rng = worker->seed;
+
+	for (int t = 0; t < worker->tableCount; t++) {
+		tables[t] = Sim_CreateTable();
+		Sim_BindTable(tables[t]);
+		Sim_EnableStats(m_bStats);
+		Sim_LoadGame(worker->gameID);
+	}
+
+	for (long i = 0; i < worker->events; i++) {
+		for (int t = 0; t < worker->tableCount; t++) {
+			int wasPlaying;
+
+			Sim_BindTable(tables[t]);
+			wasPlaying = Sim_IsGameInProgress();
+			SendRandomEvent();
+			if (wasPlaying && !Sim_IsGameInProgress())
+				worker->games++;
+		}
+	}
+
+	for (int t = 0; t < worker->tableCount; t++) {
+		if (worker->pStats)
+			Stats_Merge(worker->pStats, tables[t]->pStats);
+		Sim_DestroyTable(tables[t]);
+	}
+
+	Sim_BindTable(0);
+	free(tables);
+	return 0;
+}
+
+// Spreads tableCount independent tables of one game over a pool of threads.
+static void RunTablePool(int gameID, int tableCount, int threadCount, long events, unsigned int seed)
+{
+	TableWorker *workers;
+	pthread_t *threads;
+	StatsSet *pTotal = 0;
+	long games = 0;
+	double start, elapsed;
+
+	if (threadCount > tableCount)
+		threadCount = tableCount;
+
+	workers = (TableWorker *)calloc(threadCount, sizeof(TableWorker));
+	threads = (pthread_t *)calloc(threadCount, sizeof(pthread_t));
+	if (m_bStats)
+		pTotal = (StatsSet *)calloc(1, sizeof(StatsSet));
+
+	start = NowSeconds();
+	for (int i = 0; i < threadCount; i++) {
+		workers[i].gameID = gameID;
+		workers[i].tableCount = tableCount / threadCount + (i < tableCount % threadCount);
+		workers[i].events = events;
+		workers[i].seed = seed + i * 7919;
+		if (m_bStats)
+			workers[i].pStats = (StatsSet *)calloc(1, sizeof(StatsSet));
+		pthread_create(&threads[i], 0, RunTables, &workers[i]);
+	}
+
+	for (int i = 0; i < threadCount; i++) {
+		pthread_join(threads[i], 0);
+		games += workers[i].games;
+		if (pTotal) {
+			Stats_Merge(pTotal, workers[i].pStats);
+			free(workers[i].pStats);
+		}
+	}
+	elapsed = NowSeconds() - start;
+
+	printf("%-16s %4d tables %3d threads %10ld events %8.3f s %12.0f events/s %8ld games finished\n",
+		m_gameNames[gameID], tableCount, threadCount, events * tableCount, elapsed,
+		elapsed > 0 ? events * tableCount / elapsed : 0.0, games);
+
+	if (pTotal) {
+		Stats_Print(stdout, pTotal, m_gameNames, GAMEID_COUNT);
+		free(pTotal);
+	}
+	free(threads);
+	free(workers);
+}
+
+static void SetSeed(const char *seed)
+{
+	m_rng = seed ? (unsigned int)strtoul(seed, 0, 10) : 1;
+	if (m_rng == 0)
+		m_rng = 1;
+}
+
+// Runs the random driver for one game with every event going to a log file.
+static int Record(const char *path, const char *which, long events)
+{
+	EventRecorder rec;
+
+	for (int i = 0; i < GAMEID_COUNT; i++) {
+		if (strcmp(which, m_gameNames[i]) != 0)
+			continue;
+
+		if (EventLog_OpenRecorder(&rec, path) != 0) {
+			fprintf(stderr, "can't create %s\n", path);
+			return 1;
+		}
+
+		Sim_SetRecorder(&rec);
+		RunGame(i, events);
+		Sim_SetRecorder(0);
+
+		printf("recorded %lu events to %s\n", rec.count, path);
+		EventLog_CloseRecorder(&rec);
+		return 0;
+	}
+
+	fprintf(stderr, "unknown game %s\n", which);
+	return 1;
+}
+
+static int Replay(const char *path, int bPaced)
+{
+	double start, elapsed;
+	long events;
+
+	Sim_EnableStats(1);
+	start = NowSeconds();
+	events = EventLog_Replay(path, bPaced);
+	elapsed = NowSeconds() - start;
+	if (events < 0) {
+		fprintf(stderr, "can't read %s\n", path);
+		return 1;
+	}
+
+	printf("replayed %ld events in %.3f s (%.0f events/s)\n", events, elapsed, elapsed > 0 ? events / elapsed : 0.0);
+	Stats_Print(stdout, Sim_GetTable()->pStats, m_gameNames, GAMEID_COUNT);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	const char *which = argc > 1 ? argv[1] : "all";
+
+	Checkers_RegisterGame(GAMEID_CHECKERS);
+	ChineseCheckers_RegisterGame(GAMEID_CHINESECHECKERS);
+	Go_RegisterGame(GAMEID_GO);
+	Popout_RegisterGame(GAMEID_POPOUT);
+	StraightEdge_RegisterGame(GAMEID_STRAIGHTEDGE);
+
+	if (strcmp(which, "record") == 0 && argc > 3) {
+		SetSeed(argc > 5 ? argv[5] : 0);
+		return Record(argv[2], argv[3], argc > 4 ? atol(argv[4]) : 1000000);
+	}
+
+	if (strcmp(which, "replay") == 0 && argc > 2)
+		return Replay(argv[2], argc > 3 && strcmp(argv[3], "paced") == 0);
+
+	if (strcmp(which, "perft") == 0 && argc > 3 && DV_FindVariant(argv[2]))
+		return Perft_RunVariant(argv[2], atoi(argv[3]));
+
+	if (strcmp(which, "perft") == 0 && argc > 2)
+		return Perft_Run(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : 0, argc > 4 ? argv[4] : 0);
+
+	if (strcmp(which, "tbgen") == 0 && argc > 2)
+		return TBGen_Generate(argv[2], argc > 3 ? atoi(argv[3]) : 4);
+
+	if (strcmp(which, "tbprobe") == 0 && argc > 3)
+		return TBGen_Probe(argv[2], argv[3]);
+
+	if (strcmp(which, "bookgen") == 0 && argc > 3)
+		return Book_Build(argv[2], atoi(argv[3]), argc > 4 ? atoi(argv[4]) : 16, argc > 5 ? argv[5] : 0, argc > 6 ? (unsigned int)atol(argv[6]) : 1);
+
+	if (strcmp(which, "gobench") == 0)
+		return GoBench_Run(argc > 2 ? atof(argv[2]) : 2.0, argc > 3 ? atoi(argv[3]) : 1);
+
+	if (strcmp(which, "gocheck") == 0)
+		return GoCheck_Run() != 0;
+
+	if (getenv("PINKSIM_CHECKERS_BOOK")) {
+		if (CK_OpenBook(&m_book, getenv("PINKSIM_CHECKERS_BOOK")) != 0) {
+			fprintf(stderr, "can't map %s\n", getenv("PINKSIM_CHECKERS_BOOK"));
+			return 1;
+		}
+		Checkers_SetBook(&m_book);
+	}
+
+	if (getenv("PINKSIM_CHECKERS_TB")) {
+		if (CK_OpenTablebase(&m_tablebase, getenv("PINKSIM_CHECKERS_TB")) != 0) {
+			fprintf(stderr, "can't map %s\n", getenv("PINKSIM_CHECKERS_TB"));
+			return 1;
+		}
+		Checkers_SetTablebase(&m_tablebase);
+	}
+
+	if (getenv("PINKSIM_CHECKERS_MOVEMS"))
+		m_checkersMoveMillis = atol(getenv("PINKSIM_CHECKERS_MOVEMS"));
+	Sim_SetLoadHook(OnGameLoaded);
+
+	if (getenv("PINKSIM_GO_THREADS"))
+		Go_SetSearchThreads(atoi(getenv("PINKSIM_GO_THREADS")));
+
+	if (strcmp(which, "stats") == 0) {
+		m_bStats = 1;
+		Sim_EnableStats(1);
+		argv++;
+		argc--;
+		which = argc > 1 ? argv[1] : "all";
+	}
+
+	if (strcmp(which, "tables") == 0 && argc > 4) {
+		int tableCount = atoi(argv[3]), threadCount = atoi(argv[4]);
+
+		SetSeed(argc > 6 ? argv[6] : 0);
+		if (tableCount < 1 || threadCount < 1) {
+			fprintf(stderr, "need at least one table and one thread\n");
+			return 1;
+		}
+
+		for (int i = 0; i < GAMEID_COUNT; i++) {
+			if (strcmp(argv[2], "all") == 0 || strcmp(argv[2], m_gameNames[i]) == 0)
+				RunTablePool(i, tableCount, threadCount, argc > 5 ? atol(argv[5]) : 100000, m_rng);
+		}
+		return 0;
+	}
+
+	SetSeed(argc > 3 ? argv[3] : 0);
+	for (int i = 0; i < GAMEID_COUNT; i++) {
+		if (strcmp(which, "all") == 0 || strcmp(which, m_gameNames[i]) == 0)
+			RunGame(i, argc > 2 ? atol(argv[2]) : 1000000);
+	}
+
+	if (m_bStats)
+		Stats_Print(stdout, Sim_GetTable()->pStats, m_gameNames, GAMEID_COUNT);
+	return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright 2018 Taylor Grubbs
+
+/*This file is part of the The Player Illuminated Negativity Killer Source Code.
+
+The Player Illuminated Negativity Killer Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The Player Illuminated Negativity Killer Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with The Player Illuminated Negativity Killer Source Code.  If not, see <http://www.gnu.org/licenses/>.*/
+
+
+//###############################################################
+//# StandardGameIncludes.h (host build)
+//# Stand-in for the table firmware's game API so the games can be
+//# compiled and driven on a Linux host by HostSimulator.c.
+//# Only used when host/ is on the include path, never on the table.
+//###############################################################
+#pragma once
+
+#define HOST_SIMULATOR 1
+
+// Game callbacks have no special linkage off-device.
+#define GF_PREFIX
+
+#define MAX_GAMES 16
+
+// Largest board the simulated LED matrix can hold.
+#define SIM_MAX_BOARDSIZE 19
+
+// LED Colors.  GC_DARK is added to a base color to get its dim shade.
+#define GC_INVALID 0
+#define GC_GRAY 1
+#define GC_WHITE 2
+#define GC_RED 3
+#define GC_BLUE 4
+#define GC_ORANGE 5
+#define GC_PURPLE 6
+#define GC_PINK 7
+#define GC_YELLOW 8
+#define GC_GREEN 9
+#define GC_DARK 16
+
+// LCD game messages
+#define SPT_GAMEMESSAGE_GENERICSETUP 0
+#define SPT_GAMEMESSAGE_GENERICSTART 1
+#define SPT_GAMEMESSAGE_REDVICTORY 2
+#define SPT_GAMEMESSAGE_BLUEVICTORY 3
+#define SPT_GAMEMESSAGE_TIEGAME 4
+
+// Menu option strings
+#define SPT_OPTIONS_STARTGAME 16
+#define SPT_OPTIONS_RESTARTGAME 17
+#define SPT_OPTIONS_TURNTIMERS 18
+#define SPT_OPTIONS_RESTART 19
+#define SPT_OPTIONS_RECONFIGURE 20
+#define SPT_OPTIONS_COMPUTERPLAYER 21
+#define SPT_OPTIONS_SUGGESTMOVE 22
+
+#define SPT_UTIL_ON 32
+#define SPT_UTIL_OFF 33
+
+// Game titles and descriptions
+#define SPT_GT_CHECKERS 48
+#define SPT_GT_CHINESECHECKERS 49
+#define SPT_GT_GO 50
+#define SPT_GT_POPOUT 51
+#define SPT_GT_STRAIGHTEDGE 52
+
+#define SPT_GD_CHECKERS 64
+#define SPT_GD_GO 65
+#define SPT_GD_POPOUT 66
+#define SPT_GD_STRAIGHTEDGE 67
+
+// Images
+#define IMAGEID_NONE 0
+#define IMAGEID_GAMEICON_TILEFLIP 1
+
+// LCD timers and score displays
+#define TM_LCD_TIMER_PLAYER1 0
+#define TM_LCD_TIMER_PLAYER2 1
+#define TM_LCD_SCORE_PLAYER1 0
+#define TM_LCD_SCORE_PLAYER2 1
+
+#define GDCONFIG_ONEPLAYER 0
+#define GDCONFIG_TWOPLAYERS 1
+
+// LCD buttons
+#define LCDB_EXTRA1 0
+#define LCDB_EXTRA2 1
+
+// Sounds
+#define SOUNDID_GAMESTART 0
+#define SOUNDID_DENY 1
+
+typedef struct
+{
+	int printNamePreset;
+	int descriptionPreset;
+	int gameIconID;
+	int (*p_OnGameLoaded)();
+	void (*p_OnButtonPressed)(int x, int y);
+	void (*p_OnLCDButtonPressed)(int id);
+	void (*p_OnTimerFinished)(int id);
+	void (*p_OnLCDTimerHitZero)(int id);
+	void (*p_OnIdle)();
+	void (*p_OnWake)(int reason);
+	void (*p_OnExit)(int reason);
+	void (*p_OnMenuOptionSelected)(int id);
+} BoardGameInfo;
+
+extern BoardGameInfo BoardGameInfoList[MAX_GAMES];
+
+// Board
+void SetBoardSize(int width, int height);
+void IlluminateBoard(int color);
+void IlluminateButton(int x, int y, int color);
+int GetButtonColorAtPos(int x, int y);
+void SetColorMode(int mode);
+
+// LCD
+void SetLCDGameMessage(int message);
+void SetLCDGameDisplayFormat(int format);
+void SetLCDScoreDisplayValue(int id, int value);
+void SetLCDTimerValue(int id, int seconds);
+void SetLCDTimerCountMode(int id, int mode);
+
+// Menu
+void ClearAllMenuOptions();
+void RegisterMenuOption(int stringPreset, int imageID, int slot);
+void RegisterMenuOptionWithStringParameter(int stringPreset, int imageID, int parameterPreset, int slot);
+
+// Misc
+void PlaySoundPreset(int id);
+void PrintDebugMessage(const char *message);